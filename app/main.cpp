@@ -1,22 +1,40 @@
-#include "clang/Frontend/CompilerInstance.h"
-#include "clang/Frontend/FrontendAction.h"
 #include "clang/Tooling/CommonOptionsParser.h"
 #include "clang/Tooling/Tooling.h"
+#include "llvm/Support/Threading.h"
 
 #include "dsannotation/config/ParserConfig.h"
-#include "dsannotation/core/ErrorCollector.h"
-#include "dsannotation/parsing/ASTVisitor.h"
-#include "dsannotation/parsing/ComponentParser.h"
-#include "dsannotation/parsing/PropertyParser.h"
-#include "dsannotation/parsing/ReferenceParser.h"
+#include "dsannotation/parsing/ComponentRegistry.h"
+#include "dsannotation/parsing/ValidationCache.h"
+#include "dsannotation/serialization/CanonicalOrder.h"
+#include "dsannotation/serialization/ComponentFragment.h"
 #include "dsannotation/serialization/JsonManifestBuilder.h"
-#include "dsannotation/serialization/JsonManifestWriter.h"
+#include "dsannotation/serialization/ManifestAccumulator.h"
 #include "dsannotation/serialization/ManifestMerger.h"
+#include "dsannotation/serialization/StreamingManifestWriter.h"
+#include "dsannotation/support/ContentHash.h"
 #include "dsannotation/support/ErrorReporter.h"
+#include "dsannotation/support/CachingFileSystem.h"
 #include "dsannotation/support/LocalFileSystem.h"
+#include "dsannotation/support/MappedFile.h"
+#include "dsannotation/tooling/AnnotationPrefilter.h"
+#include "dsannotation/tooling/FragmentStore.h"
+#include "dsannotation/tooling/ScanCache.h"
+#include "dsannotation/tooling/ScanExecutor.h"
+#include "dsannotation/tooling/ScanResults.h"
+#include "dsannotation/tooling/ShardPartition.h"
 
-#include <memory>
-#include <utility>
+#include <algorithm>
+#include <cstdint>
+#include <exception>
+#include <filesystem>
+#include <iostream>
+#include <map>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <unordered_set>
+#include <vector>
 
 using namespace clang::tooling;
 using namespace llvm;
@@ -39,83 +57,456 @@ static cl::opt<std::string> OutputDir(
     cl::cat(ToolCategory),
     cl::Optional);
 
-class ComponentASTConsumer : public clang::ASTConsumer {
-public:
-    explicit ComponentASTConsumer(config::ParserConfig config)
-        : config_(std::move(config)) {}
+static cl::opt<unsigned> Jobs(
+    "j",
+    cl::desc("Number of translation units to parse in parallel (0 = all cores)"),
+    cl::value_desc("N"),
+    cl::cat(ToolCategory),
+    cl::init(1));
+
+static cl::opt<config::ScanProfile> Profile(
+    "scan-profile",
+    cl::desc("Frontend profile used to parse translation units"),
+    cl::values(clEnumValN(config::ScanProfile::Full, "full",
+                          "Project compile flags and full semantic analysis"),
+               clEnumValN(config::ScanProfile::Declarations, "declarations",
+                          "Syntax-only, skip function bodies, drop warning/optimization/codegen flags")),
+    cl::cat(ToolCategory),
+    cl::init(config::ScanProfile::Full));
+
+static cl::opt<config::DiscoveryMode> Discovery(
+    "discovery",
+    cl::desc("How annotated classes are located in a translation unit"),
+    cl::values(clEnumValN(config::DiscoveryMode::Declarations, "declarations",
+                          "Visit every class and check its doc comment"),
+               clEnumValN(config::DiscoveryMode::Contexts, "contexts",
+                          "Visit classes in namespaces and classes only, skip function bodies"),
+               clEnumValN(config::DiscoveryMode::Comments, "comments",
+                          "Start from comments containing @component")),
+    cl::cat(ToolCategory),
+    cl::init(config::DiscoveryMode::Declarations));
+
+static cl::opt<bool> SkipSystemHeaders(
+    "skip-system-headers",
+    cl::desc("Ignore declarations located in system headers"),
+    cl::cat(ToolCategory),
+    cl::init(true));
+
+static cl::list<std::string> IncludePrefixes(
+    "include-prefix",
+    cl::desc("Only look for components in files under this path (repeatable)"),
+    cl::value_desc("path"),
+    cl::cat(ToolCategory),
+    cl::ZeroOrMore);
+
+static cl::list<std::string> ExcludePrefixes(
+    "exclude-prefix",
+    cl::desc("Ignore files under this path, e.g. third-party code (repeatable)"),
+    cl::value_desc("path"),
+    cl::cat(ToolCategory),
+    cl::ZeroOrMore);
+
+static cl::opt<bool> Prefilter(
+    "prefilter",
+    cl::desc("Skip translation units whose sources and user headers contain no @component, "
+             "assuming unresolved angled includes are implicit system headers"),
+    cl::cat(ToolCategory),
+    cl::init(false));
+
+static cl::opt<std::string> CacheDir(
+    "cache-dir",
+    cl::desc("Reuse results of unchanged translation units from this directory"),
+    cl::value_desc("directory"),
+    cl::cat(ToolCategory),
+    cl::Optional);
+
+static cl::opt<std::string> FragmentDir(
+    "fragment-dir",
+    cl::desc("Also write each translation unit's components as a binary fragment to this directory"),
+    cl::value_desc("directory"),
+    cl::cat(ToolCategory),
+    cl::Optional);
+
+static cl::opt<std::string> Shard(
+    "shard",
+    cl::desc("Scan only shard i of N of the translation units, partitioned by source path hash"),
+    cl::value_desc("i/N"),
+    cl::cat(ToolCategory),
+    cl::Optional);
+
+static cl::opt<bool> CanonicalOrder(
+    "canonical-order",
+    cl::desc("Sort components by implementation-class and references by name"),
+    cl::cat(ToolCategory),
+    cl::init(false));
+
+// dsannotation merge [-o <directory>] <input>...
+static cl::SubCommand MergeCommand("merge", "Merge manifests and fragments into one manifest");
+
+static cl::list<std::string> MergeInputs(
+    cl::Positional,
+    cl::desc("<manifest.json | fragment.dsfrag | fragment directory>..."),
+    cl::sub(MergeCommand),
+    cl::OneOrMore);
+
+static cl::opt<std::string> MergeOutputDir(
+    "o",
+    cl::desc("Specify output directory for manifest.json"),
+    cl::value_desc("directory"),
+    cl::sub(MergeCommand),
+    cl::Optional);
+
+static cl::opt<bool> MergeCanonicalOrder(
+    "canonical-order",
+    cl::desc("Sort components by implementation-class and references by name"),
+    cl::sub(MergeCommand),
+    cl::init(false));
+
+// Run-level aggregation stage: translation units only contribute
+// components, the manifest is built, merged and written exactly once.
+static void writeManifest(const core::ComponentList& components,
+                          const config::ParserConfig& config,
+                          std::vector<core::Error>& errors) {
+    support::LocalFileSystem fileSystem;
+    serialization::JsonManifestBuilder manifestBuilder;
+    serialization::ManifestMerger manifestMerger(fileSystem);
+    const int indentation = config.compactJson ? -1 : config.jsonIndentation;
+    serialization::StreamingManifestWriter manifestWriter(manifestBuilder,
+                                                           manifestMerger,
+                                                           fileSystem,
+                                                           indentation,
+                                                           config.canonicalOrder);
+
+    auto manifestResult = manifestWriter.writeManifest(components,
+                                                       config.inputManifestPath.value_or(""),
+                                                       config.outputPath());
+    if (manifestResult.hasError()) {
+        errors.push_back(core::Error{manifestResult.error(),
+                                     std::string{},
+                                     core::ErrorSeverity::Error,
+                                     core::ErrorCategory::General});
+    } else if (!manifestResult.value() && config.verboseOutput) {
+        std::cout << "Manifest unchanged, not rewritten: " << config.outputPath() << '\n';
+    }
+}
+
+// Shard keys are relative to each source's compile directory, so the
+// partition does not depend on where a node checked out or built the tree.
+static std::vector<std::string> partitionKeys(const CompilationDatabase& compilations,
+                                              const std::vector<std::string>& sourcePaths) {
+    std::vector<std::string> keys;
+    keys.reserve(sourcePaths.size());
+    for (const auto& sourcePath : sourcePaths) {
+        const auto absolutePath = clang::tooling::getAbsolutePath(sourcePath);
+        const auto commands = compilations.getCompileCommands(absolutePath);
+        keys.push_back(tooling::partitionKey(absolutePath, commands.empty() ? std::string{} : commands.front().Directory));
+    }
+    return keys;
+}
+
+static int runScan(const CompilationDatabase& compilations,
+                   const std::vector<std::string>& sourcePaths,
+                   const config::ParserConfig& config,
+                   unsigned jobs) {
+    support::LocalFileSystem fileSystem;
+    std::optional<tooling::ScanCache> cache;
+    if (config.cacheDirectory) {
+        cache.emplace(*config.cacheDirectory, fileSystem);
+    }
+
+    const auto keys = partitionKeys(compilations, sourcePaths);
+    std::optional<tooling::FragmentStore> fragments;
+    if (config.fragmentDirectory) {
+        fragments.emplace(*config.fragmentDirectory, fileSystem, tooling::runIdentity(keys), config.shard);
+    }
 
-    void HandleTranslationUnit(clang::ASTContext& context) override {
-        support::LocalFileSystem fileSystem;
-        parsing::PropertyParser propertyParser;
-        parsing::ReferenceParser referenceParser(propertyParser);
-        core::ErrorCollector errorCollector(context.getSourceManager());
+    std::optional<tooling::AnnotationPrefilter> prefilter;
+    if (config.prefilterSources) {
+        prefilter.emplace(!config.skipSystemHeaders);
+    }
+
+    parsing::ComponentRegistry registry;
+    parsing::ValidationCache validationCache;
+    support::CachingFileSystem propertyFiles(fileSystem);
+    tooling::ScanSession session{config,
+                                 &registry,
+                                 cache ? &*cache : nullptr,
+                                 prefilter ? &*prefilter : nullptr,
+                                 &validationCache,
+                                 &propertyFiles,
+                                 fragments ? &*fragments : nullptr};
 
-        parsing::ComponentParser componentParser(propertyParser,
-                                                 referenceParser,
-                                                 fileSystem,
-                                                 errorCollector,
-                                                 config_);
+    // Every shard keeps the ordinals of the full source list, so fragments
+    // of all shards merge in the order of a single run.
+    const auto ordinals = tooling::selectShard(keys, config.shard);
+    std::vector<std::string> shardPaths;
+    shardPaths.reserve(ordinals.size());
+    for (const auto ordinal : ordinals) {
+        shardPaths.push_back(sourcePaths[ordinal]);
+    }
 
-        parsing::ASTVisitor visitor(context, componentParser);
-        visitor.TraverseDecl(context.getTranslationUnitDecl());
+    tooling::ScanResults results(shardPaths, ordinals);
+    tooling::ScanExecutor executor(compilations, session, jobs);
+    const int status = executor.run(shardPaths, results);
 
-        serialization::JsonManifestBuilder manifestBuilder;
-        serialization::ManifestMerger manifestMerger(fileSystem);
-        const int indentation = config_.compactJson ? -1 : config_.jsonIndentation;
-        serialization::JsonManifestWriter manifestWriter(manifestBuilder,
-                                                          manifestMerger,
-                                                          fileSystem,
-                                                          indentation);
+    auto errors = results.errors();
+    writeManifest(results.components(), config, errors);
 
-        auto manifestResult = manifestWriter.writeManifest(visitor.components(),
-                                                           config_.inputManifestPath.value_or(""),
-                                                           config_.outputPath());
-        if (manifestResult.hasError()) {
-            errorCollector.addError(manifestResult.error(),
-                                    core::ErrorSeverity::Error,
-                                    core::ErrorCategory::General);
+    support::ErrorReporter reporter(errors);
+    if (config.verboseOutput || !errors.empty()) {
+        reporter.print();
+    }
+    if (config.verboseOutput) {
+        if (config.shard.count > 1) {
+            std::cout << "Shard " << config.shard.index << '/' << config.shard.count << ": "
+                      << shardPaths.size() << " of " << sourcePaths.size() << " translation units\n";
         }
+        std::cout << results.statistics().summary();
+        std::cout << "Components parsed: " << registry.size()
+                  << ", reused across translation units: " << registry.reuseCount() << '\n';
+        std::cout << "Validation cache: " << validationCache.hits() << " hits, "
+                  << validationCache.misses() << " misses\n";
+        std::cout << "Property file cache: " << propertyFiles.hits() << " hits, "
+                  << propertyFiles.misses() << " misses\n";
+    }
+
+    return status;
+}
+
+static bool isFragmentPath(const std::string& path) {
+    const auto extension = serialization::kFragmentExtension;
+    return path.size() >= extension.size() &&
+           std::string_view(path).substr(path.size() - extension.size()) == extension;
+}
 
-        support::ErrorReporter reporter(errorCollector);
-        if (config_.verboseOutput || !errorCollector.errors().empty()) {
-            reporter.print();
+struct MergeInput {
+    std::string path;
+    // The directory argument a fragment was found in, empty for files named
+    // on the command line.
+    std::string directory;
+};
+
+// Directories contribute their fragments sorted by file name, so the merge
+// order does not depend on directory iteration order.
+static std::vector<MergeInput> expandMergeInputs(const std::vector<std::string>& inputs) {
+    std::vector<MergeInput> expanded;
+    for (const auto& input : inputs) {
+        std::error_code error;
+        if (!std::filesystem::is_directory(input, error)) {
+            expanded.push_back(MergeInput{input, std::string{}});
+            continue;
+        }
+        std::vector<std::string> fragments;
+        for (const auto& entry : std::filesystem::directory_iterator(input, error)) {
+            if (entry.is_regular_file() && isFragmentPath(entry.path().string())) {
+                fragments.push_back(entry.path().string());
+            }
+        }
+        std::sort(fragments.begin(), fragments.end());
+        for (auto& fragment : fragments) {
+            expanded.push_back(MergeInput{std::move(fragment), input});
         }
     }
+    return expanded;
+}
 
-private:
-    config::ParserConfig config_;
+struct LoadedFragment {
+    MergeInput input;
+    serialization::ComponentFragment fragment;
 };
 
-class ComponentAction : public clang::ASTFrontendAction {
-public:
-    explicit ComponentAction(config::ParserConfig config)
-        : config_(std::move(config)) {}
+// A scan only ever replaces its own fragments, so a reused directory can
+// still hold fragments of an earlier run over a different source list or
+// shard count. Those would silently mix into the result; reject them.
+static std::vector<std::string> checkFragmentRuns(const std::vector<LoadedFragment>& fragments) {
+    std::vector<std::string> problems;
+    std::map<std::string, const LoadedFragment*> firstInDirectory;
+    std::map<std::uint64_t, const LoadedFragment*> firstOfRun;
+    std::map<std::pair<std::uint64_t, std::uint64_t>, const LoadedFragment*> sources;
+    for (const auto& loaded : fragments) {
+        const auto& fragment = loaded.fragment;
+        if (!loaded.input.directory.empty()) {
+            const auto* first = firstInDirectory.emplace(loaded.input.directory, &loaded).first->second;
+            if (first->fragment.runIdentity != fragment.runIdentity ||
+                first->fragment.shardCount != fragment.shardCount) {
+                problems.push_back("Fragment directory " + loaded.input.directory +
+                                   " holds fragments of different scans (" + first->input.path + " and " +
+                                   loaded.input.path + "); clear it and scan again");
+                continue;
+            }
+        }
+        const auto* first = firstOfRun.emplace(fragment.runIdentity, &loaded).first->second;
+        if (first->fragment.shardCount != fragment.shardCount) {
+            problems.push_back("Fragment " + loaded.input.path + " was written by shard " +
+                               std::to_string(fragment.shardIndex) + '/' + std::to_string(fragment.shardCount) +
+                               " of a run that " + first->input.path + " splits into " +
+                               std::to_string(first->fragment.shardCount) + " shards");
+            continue;
+        }
+        const auto* same = sources.emplace(std::make_pair(fragment.runIdentity, fragment.ordinal), &loaded).first->second;
+        if (same != &loaded) {
+            problems.push_back("Fragments " + same->input.path + " and " + loaded.input.path +
+                               " both cover " + fragment.sourcePath + " of the same run");
+        }
+    }
+    return problems;
+}
 
-    std::unique_ptr<clang::ASTConsumer> CreateASTConsumer(clang::CompilerInstance& CI,
-                                                          llvm::StringRef) override {
-        return std::make_unique<ComponentASTConsumer>(config_);
+// Components of the fragments of one run in the order of that run: by
+// source ordinal, the first definition of each implementation class wins.
+// Ordinals are only comparable within a run.
+static core::ComponentList orderFragmentComponents(std::vector<LoadedFragment> fragments) {
+    std::sort(fragments.begin(), fragments.end(), [](const auto& lhs, const auto& rhs) {
+        return std::tie(lhs.fragment.ordinal, lhs.fragment.sourcePath) <
+               std::tie(rhs.fragment.ordinal, rhs.fragment.sourcePath);
+    });
+    core::ComponentList components;
+    std::unordered_set<std::string> seen;
+    for (auto& loaded : fragments) {
+        for (auto& component : loaded.fragment.components) {
+            if (seen.insert(component.className()).second) {
+                components.push_back(std::move(component));
+            }
+        }
     }
+    return components;
+}
 
-private:
-    config::ParserConfig config_;
-};
+// Folds the inputs in command-line order with the same override semantics
+// as a scan merged into an existing manifest (-i). Each manifest is one
+// step; the fragments of one run form a single generated manifest at the
+// position of the run's first fragment. Merging the fragments of every
+// shard therefore reproduces the unsharded manifest byte for byte.
+static int runMerge(const std::vector<std::string>& inputs, const config::ParserConfig& config) {
+    support::LocalFileSystem fileSystem;
+    serialization::JsonManifestBuilder manifestBuilder;
+    serialization::ManifestAccumulator accumulator;
+    std::vector<core::Error> errors;
+    auto addError = [&errors](std::string message) {
+        errors.push_back(core::Error{std::move(message),
+                                     std::string{},
+                                     core::ErrorSeverity::Error,
+                                     core::ErrorCategory::General});
+    };
+    // Reported, but the manifest is still written
+    std::vector<core::Error> warnings;
 
-class ComponentActionFactory : public clang::tooling::FrontendActionFactory {
-public:
-    explicit ComponentActionFactory(config::ParserConfig config)
-        : config_(std::move(config)) {}
+    std::size_t merged = 0;
+    try {
+        const auto expanded = expandMergeInputs(inputs);
+        if (expanded.empty()) {
+            addError("No manifests or fragments to merge");
+        }
 
-    std::unique_ptr<clang::FrontendAction> create() override {
-        return std::make_unique<ComponentAction>(config_);
+        // A run is complete only once every input has been seen, so
+        // fragments are loaded up front; manifests are read while folding.
+        std::vector<LoadedFragment> fragments;
+        for (const auto& input : expanded) {
+            if (!isFragmentPath(input.path)) {
+                continue;
+            }
+            auto fragment = serialization::readFragment(input.path);
+            if (!fragment) {
+                addError("Unable to read fragment: " + input.path);
+                continue;
+            }
+            // The source is only checked where it is readable; a merge does
+            // not need the sources.
+            if (auto source = support::MappedFile::open(fragment->sourcePath);
+                source && support::hashContent(source->contents()) != fragment->sourceFingerprint) {
+                warnings.push_back(core::Error{"Fragment " + input.path + " is stale: " + fragment->sourcePath +
+                                                   " has changed since it was scanned",
+                                               std::string{},
+                                               core::ErrorSeverity::Warning,
+                                               core::ErrorCategory::General});
+            }
+            fragments.push_back(LoadedFragment{input, std::move(*fragment)});
+            ++merged;
+        }
+        for (auto& problem : checkFragmentRuns(fragments)) {
+            addError(std::move(problem));
+        }
+
+        std::vector<std::uint64_t> fragmentRuns;
+        std::map<std::uint64_t, std::vector<LoadedFragment>> runs;
+        for (auto& loaded : fragments) {
+            fragmentRuns.push_back(loaded.fragment.runIdentity);
+            runs[loaded.fragment.runIdentity].push_back(std::move(loaded));
+        }
+
+        std::size_t nextFragment = 0;
+        for (const auto& input : expanded) {
+            if (!errors.empty()) {
+                break;
+            }
+            if (isFragmentPath(input.path)) {
+                auto run = runs.find(fragmentRuns[nextFragment++]);
+                if (run != runs.end()) {
+                    accumulator.add(manifestBuilder.buildManifest(orderFragmentComponents(std::move(run->second))));
+                    runs.erase(run);
+                }
+                continue;
+            }
+            auto manifest = fileSystem.readJsonFile(input.path);
+            if (!manifest) {
+                addError("Unable to read manifest: " + input.path);
+                continue;
+            }
+            accumulator.add(std::move(*manifest));
+            ++merged;
+        }
+
+        if (errors.empty()) {
+            auto manifest = accumulator.release();
+            if (manifest.is_null()) {
+                addError("No manifest content to merge");
+            } else {
+                if (config.canonicalOrder) {
+                    serialization::sortManifest(manifest);
+                }
+                const int indentation = config.compactJson ? -1 : config.jsonIndentation;
+                const auto status = fileSystem.writeTextFile(config.outputPath(), manifest.dump(indentation));
+                if (status == support::WriteStatus::Failed) {
+                    addError("Failed to write manifest to " + config.outputPath());
+                } else if (status == support::WriteStatus::Unchanged && config.verboseOutput) {
+                    std::cout << "Manifest unchanged, not rewritten: " << config.outputPath() << '\n';
+                }
+            }
+        }
+    } catch (const std::exception& ex) {
+        addError(ex.what());
     }
 
-private:
-    config::ParserConfig config_;
-};
+    const bool failed = !errors.empty();
+    errors.insert(errors.end(), warnings.begin(), warnings.end());
+    support::ErrorReporter reporter(errors);
+    if (config.verboseOutput || !errors.empty()) {
+        reporter.print();
+    }
+    if (config.verboseOutput) {
+        std::cout << "Inputs merged: " << merged << '\n';
+    }
+    return failed ? 1 : 0;
+}
 
 } // namespace dsannotation::app
 
 int main(int argc, const char** argv) {
+    // The merge subcommand needs no compilation database, so it is handled
+    // before CommonOptionsParser insists on one.
+    if (argc > 1 && llvm::StringRef(argv[1]) == dsannotation::app::MergeCommand.getName()) {
+        cl::ParseCommandLineOptions(argc, argv, "Merges manifests and fragments into one manifest\n");
+
+        dsannotation::config::ParserConfig config;
+        if (!dsannotation::app::MergeOutputDir.getValue().empty()) {
+            config.outputDirectory = dsannotation::app::MergeOutputDir.getValue();
+        }
+        config.canonicalOrder = dsannotation::app::MergeCanonicalOrder.getValue();
+        const std::vector<std::string> inputs(dsannotation::app::MergeInputs.begin(),
+                                              dsannotation::app::MergeInputs.end());
+        return dsannotation::app::runMerge(inputs, config);
+    }
+
     auto expectedParser = CommonOptionsParser::create(argc, argv, dsannotation::app::ToolCategory);
     if (!expectedParser) {
         llvm::errs() << expectedParser.takeError();
@@ -123,7 +514,6 @@ int main(int argc, const char** argv) {
     }
 
     CommonOptionsParser& optionsParser = expectedParser.get();
-    ClangTool tool(optionsParser.getCompilations(), optionsParser.getSourcePathList());
 
     dsannotation::config::ParserConfig config;
     if (!dsannotation::app::OutputDir.getValue().empty()) {
@@ -132,7 +522,38 @@ int main(int argc, const char** argv) {
     if (!dsannotation::app::InputManifest.getValue().empty()) {
         config.inputManifestPath = dsannotation::app::InputManifest.getValue();
     }
+    config.scanProfile = dsannotation::app::Profile.getValue();
+    config.discoveryMode = dsannotation::app::Discovery.getValue();
+    config.skipSystemHeaders = dsannotation::app::SkipSystemHeaders.getValue();
+    config.includePathPrefixes.assign(dsannotation::app::IncludePrefixes.begin(),
+                                      dsannotation::app::IncludePrefixes.end());
+    config.excludePathPrefixes.assign(dsannotation::app::ExcludePrefixes.begin(),
+                                      dsannotation::app::ExcludePrefixes.end());
+    config.prefilterSources = dsannotation::app::Prefilter.getValue();
+    config.canonicalOrder = dsannotation::app::CanonicalOrder.getValue();
+    if (!dsannotation::app::CacheDir.getValue().empty()) {
+        config.cacheDirectory = dsannotation::app::CacheDir.getValue();
+    }
+    if (!dsannotation::app::FragmentDir.getValue().empty()) {
+        config.fragmentDirectory = dsannotation::app::FragmentDir.getValue();
+    }
+    if (!dsannotation::app::Shard.getValue().empty()) {
+        const auto shard = dsannotation::tooling::parseShardSpec(dsannotation::app::Shard.getValue());
+        if (!shard) {
+            llvm::errs() << "Invalid --shard '" << dsannotation::app::Shard.getValue()
+                         << "', expected i/N with 0 <= i < N\n";
+            return 1;
+        }
+        config.shard = *shard;
+    }
+
+    unsigned jobs = dsannotation::app::Jobs.getValue();
+    if (jobs == 0) {
+        jobs = llvm::hardware_concurrency().compute_thread_count();
+    }
 
-    auto factory = std::make_unique<dsannotation::app::ComponentActionFactory>(config);
-    return tool.run(factory.get());
+    return dsannotation::app::runScan(optionsParser.getCompilations(),
+                                      optionsParser.getSourcePathList(),
+                                      config,
+                                      jobs);
 }
@@ -0,0 +1,73 @@
+// Measures AnnotationValidator::validateComment on large annotation
+// comments of increasing size.
+//
+//   dsannotation_validator_benchmark [iterations]
+
+#include "dsannotation/parsing/AnnotationValidator.h"
+#include "dsannotation/support/ByteScanner.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace dsannotation;
+
+namespace {
+
+// A component comment with many references and properties, padded with
+// prose so that annotations are spread over many lines.
+std::string generateComment(std::size_t targetSize) {
+    std::string comment = "/**\n * @component\n * @properties { name: \"bench\", count: 3 }\n";
+    for (std::size_t i = 0; comment.size() < targetSize; ++i) {
+        comment += " * Service dependency number " + std::to_string(i) +
+                   " is resolved at activation time (see 'docs').\n";
+        comment += " * @reference dependency" + std::to_string(i) +
+                   " { interface: \"IService\", cardinality: \"0..n\", policy: \"dynamic\" }\n";
+        if (i % 8 == 0) {
+            comment += " * @property \"config/service" + std::to_string(i) + ".json\"\n";
+        }
+    }
+    comment += " */";
+    return comment;
+}
+
+double medianMicroseconds(std::vector<double> samples) {
+    std::sort(samples.begin(), samples.end());
+    return samples[samples.size() / 2];
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const unsigned iterations = argc > 1 ? static_cast<unsigned>(std::atoi(argv[1])) : 51;
+
+    parsing::AnnotationValidator validator;
+    const support::SourceLocationInfo location{"benchmark.cpp", 10, 1};
+
+    const char* kernelNames[] = {"scalar", "SSE2", "AVX2"};
+    std::cout << "scan kernel: " << kernelNames[static_cast<int>(support::activeScanKernel())] << '\n';
+    std::cout << "size (bytes)  annotations  median (us)  throughput (MB/s)\n";
+    for (std::size_t size : {1024u, 4096u, 16384u, 61440u}) {
+        const auto comment = generateComment(size - 64);
+
+        std::size_t annotations = 0;
+        std::vector<double> samples;
+        for (unsigned i = 0; i < iterations; ++i) {
+            auto start = std::chrono::steady_clock::now();
+            auto result = validator.validateComment(comment, location);
+            auto stop = std::chrono::steady_clock::now();
+
+            annotations = result.annotations.size();
+            samples.push_back(std::chrono::duration<double, std::micro>(stop - start).count());
+        }
+
+        const double median = medianMicroseconds(std::move(samples));
+        std::cout << comment.size() << "  " << annotations << "  " << median << "  "
+                  << (median > 0 ? comment.size() / median : 0.0) << '\n';
+    }
+
+    return 0;
+}
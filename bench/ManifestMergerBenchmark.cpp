@@ -0,0 +1,81 @@
+// Measures ManifestMerger::merge for growing manifests. Half of the
+// generated components replace existing entries, half are appended; the
+// time per component should stay flat as the manifest grows.
+//
+//   dsannotation_manifest_merger_benchmark [iterations]
+
+#include "dsannotation/serialization/ManifestMerger.h"
+#include "dsannotation/support/IFileSystem.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace dsannotation;
+
+namespace {
+
+// Serves one pre-parsed manifest so that only the merge is timed
+class InMemoryManifest final : public support::IFileSystem {
+public:
+    explicit InMemoryManifest(nlohmann::json manifest)
+        : manifest_(std::move(manifest)) {}
+
+    bool exists(const std::string&) const override { return true; }
+    std::optional<std::string> readTextFile(const std::string&) const override { return manifest_.dump(); }
+    std::optional<nlohmann::json> readJsonFile(const std::string&) const override { return manifest_; }
+    support::WriteStatus writeTextFile(const std::string&, const std::string&) const override {
+        return support::WriteStatus::Written;
+    }
+
+private:
+    nlohmann::json manifest_;
+};
+
+nlohmann::json generateManifest(std::size_t first, std::size_t count) {
+    nlohmann::json components = nlohmann::json::array();
+    for (std::size_t i = first; i < first + count; ++i) {
+        components.push_back({{"implementation-class", "app::module" + std::to_string(i % 97) + "::Component" + std::to_string(i)},
+                              {"service", {{"interfaces", {"app::IService"}}}},
+                              {"immediate", i % 2 == 0}});
+    }
+    return {{"scr", {{"version", 1}, {"components", std::move(components)}}}};
+}
+
+double medianNanoseconds(std::vector<double> samples) {
+    std::sort(samples.begin(), samples.end());
+    return samples[samples.size() / 2];
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const unsigned iterations = argc > 1 ? static_cast<unsigned>(std::atoi(argv[1])) : 9;
+
+    std::cout << "existing  generated  median (ms)  ns/component\n";
+    for (std::size_t count : {1000u, 2000u, 4000u, 8000u, 16000u, 32000u}) {
+        InMemoryManifest fileSystem(generateManifest(0, count));
+        serialization::ManifestMerger merger(fileSystem);
+        const auto generated = generateManifest(count / 2, count);
+
+        std::size_t merged = 0;
+        std::vector<double> samples;
+        for (unsigned i = 0; i < iterations; ++i) {
+            auto start = std::chrono::steady_clock::now();
+            auto manifest = merger.merge("manifest.json", generated);
+            auto stop = std::chrono::steady_clock::now();
+
+            merged = manifest["scr"]["components"].size();
+            samples.push_back(std::chrono::duration<double, std::nano>(stop - start).count());
+        }
+
+        const double median = medianNanoseconds(std::move(samples));
+        std::cout << count << "  " << count << "  " << median / 1e6 << "  " << median / (2 * count)
+                  << (merged != count + count / 2 ? "  (unexpected component count)" : "") << '\n';
+    }
+
+    return 0;
+}
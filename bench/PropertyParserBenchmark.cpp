@@ -0,0 +1,70 @@
+// Measures PropertyParser::parse on attribute and reference property lists
+// typical for component annotations.
+//
+//   dsannotation_property_parser_benchmark [iterations]
+
+#include "dsannotation/parsing/PropertyParser.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace dsannotation;
+
+namespace {
+
+std::string generateProperties(std::size_t count) {
+    std::string text;
+    for (std::size_t i = 0; i < count; ++i) {
+        if (!text.empty()) {
+            text += ", ";
+        }
+        switch (i % 6) {
+        case 0: text += "name" + std::to_string(i) + " = \"service." + std::to_string(i) + "\""; break;
+        case 1: text += "cardinality = 0..n"; break;
+        case 2: text += "ranking" + std::to_string(i) + " = " + std::to_string(i * 7); break;
+        case 3: text += "timeout" + std::to_string(i) + " = 2.5"; break;
+        case 4: text += "enabled" + std::to_string(i) + " = true"; break;
+        default: text += "service.tags" + std::to_string(i) + " = [ alpha, beta , gamma ]"; break;
+        }
+    }
+    return text;
+}
+
+double medianNanoseconds(std::vector<double> samples) {
+    std::sort(samples.begin(), samples.end());
+    return samples[samples.size() / 2];
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const unsigned iterations = argc > 1 ? static_cast<unsigned>(std::atoi(argv[1])) : 2001;
+
+    parsing::PropertyParser parser;
+
+    std::cout << "properties  bytes  median (ns)  ns/property\n";
+    for (std::size_t count : {1u, 6u, 24u, 96u}) {
+        const auto text = generateProperties(count);
+
+        std::size_t keys = 0;
+        std::vector<double> samples;
+        for (unsigned i = 0; i < iterations; ++i) {
+            auto start = std::chrono::steady_clock::now();
+            auto json = parser.parse(text);
+            auto stop = std::chrono::steady_clock::now();
+
+            keys += json.size();
+            samples.push_back(std::chrono::duration<double, std::nano>(stop - start).count());
+        }
+
+        const double median = medianNanoseconds(std::move(samples));
+        std::cout << count << "  " << text.size() << "  " << median << "  " << median / count
+                  << (keys == 0 ? "  (no keys parsed)" : "") << '\n';
+    }
+
+    return 0;
+}
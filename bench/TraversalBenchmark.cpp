@@ -0,0 +1,111 @@
+// Measures ASTVisitor traversal time over a synthetic translation unit whose
+// size is dominated by function bodies, comparing the full traversal with
+// the declaration-only scope.
+//
+//   dsannotation_traversal_benchmark [functions] [iterations]
+
+#include "clang/Frontend/ASTUnit.h"
+#include "clang/Tooling/Tooling.h"
+
+#include "dsannotation/core/ErrorCollector.h"
+#include "dsannotation/parsing/ASTVisitor.h"
+#include "dsannotation/parsing/ComponentCollector.h"
+#include "dsannotation/parsing/IComponentParser.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace dsannotation;
+
+namespace {
+
+class NameOnlyParser : public parsing::IComponentParser {
+public:
+    core::Component parse(const clang::CXXRecordDecl& declaration, clang::ASTContext&) const override {
+        return core::Component(declaration.getQualifiedNameAsString());
+    }
+};
+
+std::string generateSource(unsigned functions) {
+    std::ostringstream source;
+    source << "namespace bench {\n";
+    for (unsigned i = 0; i < functions; ++i) {
+        if (i % 100 == 0) {
+            source << "/**\n * @component\n */\nclass Component" << i << " {};\n";
+        }
+        source << "int function" << i << "(int n) {\n"
+               << "    struct Local { int value; };\n"
+               << "    int total = 0;\n"
+               << "    for (int a = 0; a < n; ++a) {\n"
+               << "        for (int b = 0; b < a; ++b) {\n"
+               << "            Local local{a * b + (a ^ b) - (b << 1)};\n"
+               << "            total += local.value % 7 == 0 ? local.value : -local.value;\n"
+               << "            if (total > 1000 && (a & 1) && !(b & 3)) { total /= 3; }\n"
+               << "        }\n"
+               << "    }\n"
+               << "    auto lambda = [&](int x) { return x * total + n; };\n"
+               << "    return lambda(total) + lambda(n);\n"
+               << "}\n";
+    }
+    source << "} // namespace bench\n";
+    return source.str();
+}
+
+double medianMilliseconds(std::vector<double> samples) {
+    std::sort(samples.begin(), samples.end());
+    return samples[samples.size() / 2];
+}
+
+double measure(clang::ASTContext& context,
+               parsing::TraversalScope scope,
+               unsigned iterations,
+               std::size_t& components) {
+    NameOnlyParser parser;
+    std::vector<double> samples;
+    for (unsigned i = 0; i < iterations; ++i) {
+        core::ErrorCollector errors(context.getSourceManager());
+        parsing::ComponentCollector collector(context, parser, errors);
+        parsing::ASTVisitor visitor(collector, scope);
+
+        auto start = std::chrono::steady_clock::now();
+        visitor.TraverseDecl(context.getTranslationUnitDecl());
+        auto stop = std::chrono::steady_clock::now();
+
+        samples.push_back(std::chrono::duration<double, std::milli>(stop - start).count());
+        components = collector.components().size();
+    }
+    return medianMilliseconds(std::move(samples));
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const unsigned functions = argc > 1 ? static_cast<unsigned>(std::atoi(argv[1])) : 5000;
+    const unsigned iterations = argc > 2 ? static_cast<unsigned>(std::atoi(argv[2])) : 15;
+
+    auto unit = clang::tooling::buildASTFromCodeWithArgs(generateSource(functions),
+                                                         {"-std=c++17"},
+                                                         "traversal_benchmark.cpp");
+    if (!unit) {
+        std::cerr << "failed to build the benchmark translation unit\n";
+        return 1;
+    }
+    auto& context = unit->getASTContext();
+
+    std::size_t fullComponents = 0;
+    std::size_t scopedComponents = 0;
+    const double full = measure(context, parsing::TraversalScope::Full, iterations, fullComponents);
+    const double scoped = measure(context, parsing::TraversalScope::Declarations, iterations, scopedComponents);
+
+    std::cout << "functions: " << functions << ", iterations: " << iterations << '\n'
+              << "full traversal:        " << full << " ms (" << fullComponents << " components)\n"
+              << "declarations traversal: " << scoped << " ms (" << scopedComponents << " components)\n"
+              << "speedup: " << (scoped > 0 ? full / scoped : 0.0) << "x\n";
+
+    return fullComponents == scopedComponents ? 0 : 1;
+}
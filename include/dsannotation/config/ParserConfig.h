@@ -3,9 +3,27 @@
 #include <filesystem>
 #include <optional>
 #include <string>
+#include <vector>
 
 namespace dsannotation::config {
 
+enum class ScanProfile {
+    Full,         // Project compile flags, full semantic analysis
+    Declarations  // Syntax-only, function bodies skipped, diagnostics suppressed
+};
+
+enum class DiscoveryMode {
+    Declarations,  // Visit every class and check its doc comment
+    Contexts,      // Like Declarations, but never enter function bodies or expressions
+    Comments       // Start from comments containing @component
+};
+
+// Slice `index` of `count` of the source list (--shard i/N)
+struct ShardSpec {
+    unsigned index{0};
+    unsigned count{1};
+};
+
 struct ParserConfig {
     std::string outputDirectory{"."};
     std::optional<std::string> inputManifestPath{};
@@ -20,6 +38,29 @@ struct ParserConfig {
     // JSON formatting
     int jsonIndentation{4};
     bool compactJson{false};
+    // Sort components by implementation-class and references by name
+    bool canonicalOrder{false};
+
+    ScanProfile scanProfile{ScanProfile::Full};
+    DiscoveryMode discoveryMode{DiscoveryMode::Declarations};
+
+    // Location filter: declarations in rejected files are pruned with their
+    // whole subtree. Include prefixes, when given, whitelist paths; exclude
+    // prefixes win over include prefixes.
+    bool skipSystemHeaders{true};
+    std::vector<std::string> includePathPrefixes{};
+    std::vector<std::string> excludePathPrefixes{};
+    bool prefilterSources{false};
+
+    // Incremental scanning: per-translation-unit results are cached here
+    std::optional<std::string> cacheDirectory{};
+
+    // Binary per-translation-unit fragments are spilled here for a later
+    // `dsannotation merge`
+    std::optional<std::string> fragmentDirectory{};
+
+    // Only the translation units of this shard are scanned
+    ShardSpec shard{};
 
     bool isValid() const {
         return !outputDirectory.empty() && !outputFileName.empty();
@@ -31,6 +31,8 @@ public:
                   ErrorSeverity severity,
                   ErrorCategory category);
 
+    void addError(Error error);
+
     const std::vector<Error>& errors() const noexcept { return errors_; }
 
 private:
@@ -1,28 +1,43 @@
 #pragma once
 
-#include <vector>
-
-#include "clang/AST/ASTContext.h"
 #include "clang/AST/DeclCXX.h"
 #include "clang/AST/RecursiveASTVisitor.h"
 
 #include "dsannotation/core/Component.h"
-#include "dsannotation/parsing/IComponentParser.h"
+#include "dsannotation/parsing/ComponentCollector.h"
+#include "dsannotation/parsing/LocationFilter.h"
 
 namespace dsannotation::parsing {
 
+enum class TraversalScope {
+    Full,        // Every declaration, statement and expression
+    Declarations // Namespaces, linkage specs and records only; no Stmt subtrees
+};
+
+// Declaration-driven discovery: visits classes in the translation unit and
+// hands them to the collector.
 class ASTVisitor : public clang::RecursiveASTVisitor<ASTVisitor> {
+    using Base = clang::RecursiveASTVisitor<ASTVisitor>;
+
 public:
-    ASTVisitor(clang::ASTContext& context, const IComponentParser& componentParser);
+    explicit ASTVisitor(ComponentCollector& collector,
+                        TraversalScope scope = TraversalScope::Full,
+                        LocationFilter* filter = nullptr);
 
     bool VisitCXXRecordDecl(clang::CXXRecordDecl* declaration);
 
-    const core::ComponentList& components() const noexcept { return components_; }
+    // Pruning hooks. TraverseDecl drops subtrees rejected by the location
+    // filter; the others only prune for TraversalScope::Declarations.
+    bool TraverseDecl(clang::Decl* declaration);
+    bool TraverseStmt(clang::Stmt* statement, DataRecursionQueue* queue = nullptr);
+    bool TraverseTypeLoc(clang::TypeLoc typeLoc);
+
+    const core::ComponentList& components() const noexcept { return collector_.components(); }
 
 private:
-    clang::ASTContext& context_;
-    const IComponentParser& componentParser_;
-    core::ComponentList components_;
+    ComponentCollector& collector_;
+    TraversalScope scope_;
+    LocationFilter* filter_;
 };
 
 } // namespace dsannotation::parsing
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+#include "dsannotation/parsing/AnnotationTypes.h"
+#include "dsannotation/support/SourceLocationInfo.h"
+
+namespace dsannotation::parsing {
+
+// Annotation keyword occurrence found by AnnotationLexer. Positions are
+// relative to the lexed text so a token can be placed at any base location.
+struct AnnotationToken {
+    AnnotationType type{AnnotationType::Unknown};
+    std::size_t position{0};        // Offset of the '@'
+    unsigned lineOffset{0};         // Newlines between the text start and the '@'
+    std::size_t columnOffset{0};    // Characters between the line start and the '@'
+    std::size_t contentBegin{0};    // Brace content [contentBegin, contentEnd)
+    std::size_t contentEnd{0};
+    bool wordBoundary{false};       // False for malformed occurrences such as 'my@component1'
+    bool isValid{false};            // Word boundary and, if braced, a matching '}'
+
+    support::SourceLocationInfo locate(const support::SourceLocationInfo& base) const;
+    std::string_view content(std::string_view text) const;
+};
+
+struct AnnotationLexResult {
+    bool syntaxValid{true};
+    std::vector<ValidationError> syntaxErrors;
+    std::vector<AnnotationToken> annotations;  // Grouped by type, well-formed first, then by position
+};
+
+// Single-pass scanner for annotation comments. One left-to-right walk
+// produces the character, brace and quote diagnostics, every annotation
+// keyword occurrence with its line/column offset, and the matching brace
+// of each annotation body.
+class AnnotationLexer {
+public:
+    static AnnotationLexResult lex(std::string_view text, std::size_t maxLength);
+};
+
+} // namespace dsannotation::parsing
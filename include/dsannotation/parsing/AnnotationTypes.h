@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <vector>
 #include <optional>
 #include "nlohmann/json.hpp"
@@ -43,16 +44,21 @@ struct ValidationResult {
     }
 };
 
+// Annotation found in a comment. The content borrows from the validated
+// comment text (normally the SourceManager buffer) and is only valid while
+// that text is alive.
 struct ParsedAnnotation {
     AnnotationType type{AnnotationType::Unknown};
-    std::string content;                    // Raw content inside braces
+    std::string_view content;              // Raw content inside braces
     support::SourceLocationInfo location;  // Specific location within comment
-    nlohmann::json parsedContent;          // Pre-parsed content if valid
+    nlohmann::json parsedContent;          // Pre-parsed body: attribute object (@component),
+                                           // JSON or discarded if invalid (@properties)
     bool isValid{false};                   // Whether parsing succeeded
+    bool hasBody{false};                   // Whether a closed { ... } body follows the keyword
     
     ParsedAnnotation() = default;
-    ParsedAnnotation(AnnotationType t, std::string c, support::SourceLocationInfo loc)
-        : type(t), content(std::move(c)), location(std::move(loc)) {}
+    ParsedAnnotation(AnnotationType t, std::string_view c, support::SourceLocationInfo loc)
+        : type(t), content(c), location(std::move(loc)) {}
 };
 
 struct AnnotationValidationResult {
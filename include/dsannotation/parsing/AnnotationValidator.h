@@ -1,48 +1,52 @@
 #pragma once
 
+#include "dsannotation/parsing/AnnotationLexer.h"
 #include "dsannotation/parsing/AnnotationTypes.h"
+#include "dsannotation/parsing/IPropertyParser.h"
+#include "dsannotation/parsing/ValidationCache.h"
 #include "dsannotation/support/SourceLocationInfo.h"
 #include "dsannotation/core/Error.h"
 #include <string>
+#include <string_view>
 #include <vector>
-#include <regex>
 
 namespace dsannotation::parsing {
 
 class AnnotationValidator {
 public:
     AnnotationValidator() = default;
+    // Also pre-parses @component attribute lists with the given parser.
+    explicit AnnotationValidator(const IPropertyParser& attributeParser);
+    // Reuses lexing and pre-parsing of comment texts seen before; `cache`
+    // may be null.
+    AnnotationValidator(const IPropertyParser& attributeParser, ValidationCache* cache);
     
-    // Main validation entry point
-    AnnotationValidationResult validateComment(const std::string& commentText,
+    // Main validation entry point. Annotation contents borrow from commentText.
+    AnnotationValidationResult validateComment(std::string_view commentText,
                                              const support::SourceLocationInfo& location) const;
     
     // Individual validation methods
-    ValidationResult validateSyntax(const std::string& text) const;
+    ValidationResult validateSyntax(std::string_view text) const;
     ValidationResult validateAnnotation(const ParsedAnnotation& annotation) const;
-    std::vector<ParsedAnnotation> extractAnnotations(const std::string& commentText,
+    std::vector<ParsedAnnotation> extractAnnotations(std::string_view commentText,
                                                     const support::SourceLocationInfo& baseLocation) const;
 
 private:
-    // Basic syntax checks
-    bool checkBalancedBraces(const std::string& text, std::vector<ValidationError>& errors) const;
-    bool checkBalancedQuotes(const std::string& text, std::vector<ValidationError>& errors) const;
-    bool checkValidCharacters(const std::string& text, std::vector<ValidationError>& errors) const;
-    
-    // Annotation extraction helpers
-    std::vector<size_t> findAnnotationPositions(const std::string& text, const std::string& annotationType) const;
-    ParsedAnnotation parseAnnotationAt(const std::string& text, size_t position, 
-                                      AnnotationType type, const support::SourceLocationInfo& baseLocation) const;
-    
-    // Utility functions
-    support::SourceLocationInfo calculateLocation(const support::SourceLocationInfo& base,
-                                                 const std::string& text, size_t position) const;
-    size_t findMatchingBrace(const std::string& text, size_t openPos) const;
-    std::string extractContent(const std::string& text, size_t start, size_t end) const;
-    
+    std::vector<ParsedAnnotation> toAnnotations(const AnnotationLexResult& lexed,
+                                                std::vector<nlohmann::json> parsedContents,
+                                                std::string_view commentText,
+                                                const support::SourceLocationInfo& baseLocation) const;
+    std::vector<nlohmann::json> preparseContents(const AnnotationLexResult& lexed,
+                                                 std::string_view commentText) const;
+    nlohmann::json preparseContent(const AnnotationToken& token, std::string_view commentText) const;
+    std::shared_ptr<const ValidationCache::Entry> cachedLex(std::string_view commentText) const;
+
+    const IPropertyParser* attributeParser_{nullptr};
+    ValidationCache* cache_{nullptr};
+
     // Constants
     static constexpr size_t MAX_COMMENT_LENGTH = 64 * 1024;
     static constexpr size_t MAX_ANNOTATION_DEPTH = 10;
 };
 
-} // namespace dsannotation::parsing
\ No newline at end of file
+} // namespace dsannotation::parsing
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <vector>
+
+#include "clang/AST/ASTContext.h"
+#include "clang/AST/DeclBase.h"
+#include "clang/Basic/SourceLocation.h"
+#include "llvm/ADT/DenseMap.h"
+
+#include "dsannotation/parsing/ComponentCollector.h"
+#include "dsannotation/parsing/LocationFilter.h"
+
+namespace dsannotation::parsing {
+
+// Discovers components starting from the raw comment list instead of
+// visiting every record. Comments containing @component are indexed once
+// per translation unit; only declaration contexts that enclose one of them
+// are descended into, and only records directly preceded by one are
+// checked. A translation unit without annotated comments costs one pass
+// over its comments.
+class CommentDrivenDiscovery {
+public:
+    CommentDrivenDiscovery(clang::ASTContext& context,
+                           ComponentCollector& collector,
+                           LocationFilter* filter = nullptr);
+
+    void discover();
+
+private:
+    struct FileIndex {
+        std::vector<unsigned> annotatedComments;  // begin offsets, sorted
+        std::vector<unsigned> enclosingOffsets;   // comments and include sites, sorted
+    };
+
+    bool indexAnnotatedComments();
+    void walk(const clang::DeclContext& declContext);
+    const FileIndex* fileIndex(clang::FileID file) const;
+
+    clang::ASTContext& context_;
+    ComponentCollector& collector_;
+    LocationFilter* filter_;
+    llvm::DenseMap<clang::FileID, FileIndex> files_;
+    bool walkAll_{false};
+};
+
+} // namespace dsannotation::parsing
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "clang/AST/ASTContext.h"
+#include "clang/AST/DeclCXX.h"
+
+#include "dsannotation/core/Component.h"
+#include "dsannotation/core/ErrorCollector.h"
+#include "dsannotation/parsing/ComponentRegistry.h"
+#include "dsannotation/parsing/IComponentParser.h"
+#include "dsannotation/support/RecordingFileSystem.h"
+
+namespace dsannotation::parsing {
+
+// Turns annotated class definitions into components. Shared by the
+// discovery engines so that both apply the same comment check and registry
+// deduplication. `readRecorder`, the file system the parser reads through,
+// attributes @property reads to components so reused components carry them.
+class ComponentCollector {
+public:
+    ComponentCollector(clang::ASTContext& context,
+                       const IComponentParser& componentParser,
+                       core::ErrorCollector& errorCollector,
+                       ComponentRegistry* registry = nullptr,
+                       const support::RecordingFileSystem* readRecorder = nullptr);
+
+    // Parses the record if its doc comment carries @component.
+    void collect(clang::CXXRecordDecl& declaration);
+
+    const core::ComponentList& components() const noexcept { return components_; }
+    // Files read by other translation units for the components reused here
+    const std::vector<std::string>& dependencies() const noexcept { return dependencies_; }
+
+private:
+    ComponentRegistry::Parsed parseRecorded(clang::CXXRecordDecl& declaration);
+
+    clang::ASTContext& context_;
+    const IComponentParser& componentParser_;
+    core::ErrorCollector& errorCollector_;
+    ComponentRegistry* registry_;
+    const support::RecordingFileSystem* readRecorder_;
+    core::ComponentList components_;
+    std::vector<std::string> dependencies_;
+};
+
+} // namespace dsannotation::parsing
@@ -1,11 +1,17 @@
 #pragma once
 
+#include <optional>
 #include <string>
+#include <string_view>
+#include <vector>
 
 #include "dsannotation/config/ParserConfig.h"
 #include "dsannotation/core/Component.h"
 #include "dsannotation/core/ErrorCollector.h"
+#include "dsannotation/parsing/AnnotationTypes.h"
 #include "dsannotation/parsing/IComponentParser.h"
+#include "dsannotation/parsing/InterfaceNameCache.h"
+#include "dsannotation/parsing/ValidationCache.h"
 #include "dsannotation/parsing/IPropertyParser.h"
 #include "dsannotation/parsing/IReferenceParser.h"
 #include "dsannotation/support/IFileSystem.h"
@@ -25,18 +31,25 @@ public:
                     const IReferenceParser& referenceParser,
                     const support::IFileSystem& fileSystem,
                     core::ErrorCollector& errorCollector,
-                    const config::ParserConfig& config);
+                    const config::ParserConfig& config,
+                    ValidationCache* validationCache = nullptr);
 
     core::Component parse(const clang::CXXRecordDecl& declaration,
                           clang::ASTContext& context) const override;
 
+    // Interface-name memo of the context last parsed, nullptr before the
+    // first constructor parameter was resolved.
+    const InterfaceNameCache* interfaceNameCache() const noexcept {
+        return interfaceNames_ ? &*interfaceNames_ : nullptr;
+    }
+
 private:
     void parseComponentAttributes(core::Component& component,
-                                  const clang::RawComment& comment,
-                                  clang::ASTContext& context) const;
+                                  std::vector<ParsedAnnotation>& annotations) const;
 
     void parseProperties(core::Component& component,
-                         const clang::RawComment& comment,
+                         std::vector<ParsedAnnotation>& annotations,
+                         const support::SourceLocationInfo& commentLocation,
                          const clang::CXXRecordDecl& declaration,
                          clang::ASTContext& context) const;
 
@@ -45,18 +58,21 @@ private:
                          clang::ASTContext& context) const;
 
     void parseExternalProperties(core::Component& component,
-                                 const std::string& filePath,
+                                 std::string_view filePath,
                                  const clang::CXXRecordDecl& declaration,
                                  clang::ASTContext& context) const;
 
-    std::pair<std::string, std::string> extractInterfaceNames(const clang::ParmVarDecl& param,
-                                                              clang::ASTContext& context) const;
+    InterfaceNameCache& interfaceNames(const clang::ASTContext& context) const;
 
     const IPropertyParser& propertyParser_;
     const IReferenceParser& referenceParser_;
     const support::IFileSystem& fileSystem_;
     core::ErrorCollector& errorCollector_;
     const config::ParserConfig& config_;
+    ValidationCache* validationCache_;
+    // Parsers live for one translation unit; the cache is rebuilt whenever a
+    // different ASTContext is passed in.
+    mutable std::optional<InterfaceNameCache> interfaceNames_;
 };
 
 } // namespace dsannotation::parsing
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "dsannotation/core/Component.h"
+#include "dsannotation/core/Error.h"
+
+namespace dsannotation::parsing {
+
+// Run-wide registry of parsed components, keyed by the USR of the
+// annotated class. Header-declared components are parsed by the first
+// translation unit that reaches them; every later sighting receives a copy
+// of that result, its diagnostics and the files it was read from instead of
+// re-running validation and extraction, so each translation unit reports
+// the same results whichever of them parsed first. Safe for concurrent use
+// from multiple translation units.
+class ComponentRegistry {
+public:
+    struct Parsed {
+        core::Component component;
+        std::vector<core::Error> errors;
+        // External files read while parsing (@property files)
+        std::vector<std::string> dependencies;
+    };
+
+    struct Resolution {
+        std::optional<core::Component> component;
+        // Set for reused components: the diagnostics and files of their parse
+        std::vector<core::Error> errors;
+        std::vector<std::string> dependencies;
+        bool firstSighting{false};
+        bool conflict{false};
+    };
+
+    // `fingerprint` summarizes the annotation-relevant parts of the
+    // definition. A sighting whose fingerprint differs from the registered
+    // one is a conflicting definition; it is parsed on its own and not
+    // registered, so that which definition wins can be settled after the
+    // scan, independent of which translation unit got here first.
+    Resolution resolve(const std::string& key,
+                       std::uint64_t fingerprint,
+                       const std::function<Parsed()>& parse);
+
+    std::size_t size() const;
+    std::size_t reuseCount() const noexcept { return reuseCount_.load(); }
+    std::size_t conflictCount() const noexcept { return conflictCount_.load(); }
+
+private:
+    struct Entry {
+        std::uint64_t fingerprint;
+        std::shared_future<Parsed> parsed;
+    };
+
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, Entry> entries_;
+    std::atomic<std::size_t> reuseCount_{0};
+    std::atomic<std::size_t> conflictCount_{0};
+};
+
+} // namespace dsannotation::parsing
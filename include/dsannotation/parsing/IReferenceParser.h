@@ -3,15 +3,24 @@
 #include <string_view>
 
 #include "dsannotation/core/Reference.h"
+#include "dsannotation/parsing/ReferenceAnnotations.h"
 
 namespace dsannotation::parsing {
 
 class IReferenceParser {
 public:
     virtual ~IReferenceParser() = default;
-    virtual core::Reference parse(std::string_view referenceAnnotations,
+    virtual core::Reference parse(const ReferenceAnnotations& referenceAnnotations,
                                   std::string_view parameterName,
                                   std::string_view parameterQualifiedType) const = 0;
+
+    // Convenience for a single parameter; index the comment once and use the
+    // overload above when resolving several parameters.
+    core::Reference parse(std::string_view referenceAnnotations,
+                          std::string_view parameterName,
+                          std::string_view parameterQualifiedType) const {
+        return parse(ReferenceAnnotations(referenceAnnotations), parameterName, parameterQualifiedType);
+    }
 };
 
 } // namespace dsannotation::parsing
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+
+#include "clang/AST/ASTContext.h"
+#include "clang/AST/PrettyPrinter.h"
+#include "clang/AST/Type.h"
+
+namespace dsannotation::parsing {
+
+struct InterfaceNames {
+    std::string qualified;   // Fully qualified canonical type, e.g. "app::ILogger"
+    std::string simplified;  // Unqualified display name, e.g. "ILogger"
+};
+
+// Per-translation-unit memo of the interface names of constructor parameter
+// types. Keyed by the QualType pointer, which is unique per (sugared) type
+// within one ASTContext; the printing policies are built once.
+class InterfaceNameCache {
+public:
+    explicit InterfaceNameCache(const clang::ASTContext& context);
+
+    // The reference stays valid for the lifetime of the cache.
+    const InterfaceNames& lookup(clang::QualType parameterType);
+
+    const clang::ASTContext& context() const noexcept { return context_; }
+    std::size_t hits() const noexcept { return hits_; }
+    std::size_t misses() const noexcept { return entries_.size(); }
+
+private:
+    InterfaceNames compute(clang::QualType parameterType) const;
+
+    const clang::ASTContext& context_;
+    clang::PrintingPolicy qualifiedPolicy_;
+    clang::PrintingPolicy displayPolicy_;
+    std::unordered_map<const void*, InterfaceNames> entries_;
+    std::size_t hits_{0};
+};
+
+} // namespace dsannotation::parsing
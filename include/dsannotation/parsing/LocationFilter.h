@@ -0,0 +1,43 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "clang/AST/DeclBase.h"
+#include "clang/Basic/SourceLocation.h"
+#include "clang/Basic/SourceManager.h"
+#include "llvm/ADT/DenseMap.h"
+
+#include "dsannotation/config/ParserConfig.h"
+
+namespace dsannotation::parsing {
+
+// Decides, per file, whether declarations located there may be components.
+// System headers and paths outside the configured prefixes are rejected.
+// The classification is memoized per FileID, so pruning a subtree costs one
+// map lookup and never touches the comment list.
+class LocationFilter {
+public:
+    LocationFilter(const clang::SourceManager& sourceManager, const config::ParserConfig& config);
+
+    // False if nothing is filtered, so traversals can skip the checks.
+    bool isActive() const noexcept;
+
+    bool accepts(clang::FileID file);
+
+    // Whether the subtree rooted at the declaration must be traversed.
+    // Declarations spanning several files are kept conservatively.
+    bool accepts(const clang::Decl& declaration);
+
+private:
+    bool classify(clang::FileID file) const;
+    std::string absolutePath(clang::FileID file) const;
+
+    const clang::SourceManager& sourceManager_;
+    bool skipSystemHeaders_;
+    std::vector<std::string> includePrefixes_;
+    std::vector<std::string> excludePrefixes_;
+    llvm::DenseMap<clang::FileID, bool> decisions_;
+};
+
+} // namespace dsannotation::parsing
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <string_view>
+#include <unordered_map>
+
+namespace dsannotation::parsing {
+
+// The @reference blocks of one constructor comment, keyed by target name.
+// Built with a single scan; views point into the indexed comment text,
+// which must outlive the index.
+class ReferenceAnnotations {
+public:
+    ReferenceAnnotations() = default;
+    explicit ReferenceAnnotations(std::string_view commentText);
+
+    // Property block of '@reference <target> { ... }', or null. When a
+    // target is annotated more than once, the first block wins.
+    const std::string_view* find(std::string_view target) const;
+
+    bool empty() const noexcept { return blocks_.empty(); }
+    std::size_t size() const noexcept { return blocks_.size(); }
+
+private:
+    std::unordered_map<std::string_view, std::string_view> blocks_;
+};
+
+} // namespace dsannotation::parsing
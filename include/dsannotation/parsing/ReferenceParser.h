@@ -1,6 +1,5 @@
 #pragma once
 
-#include <regex>
 #include <string>
 
 #include "dsannotation/parsing/IReferenceParser.h"
@@ -12,7 +11,8 @@ class ReferenceParser final : public IReferenceParser {
 public:
     explicit ReferenceParser(const IPropertyParser& propertyParser);
 
-    core::Reference parse(std::string_view referenceAnnotations,
+    using IReferenceParser::parse;
+    core::Reference parse(const ReferenceAnnotations& referenceAnnotations,
                           std::string_view parameterName,
                           std::string_view parameterQualifiedType) const override;
 
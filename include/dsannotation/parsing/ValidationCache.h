@@ -0,0 +1,54 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "dsannotation/parsing/AnnotationLexer.h"
+#include "nlohmann/json.hpp"
+
+namespace dsannotation::parsing {
+
+// Run-wide, content-addressed memo of the text-dependent part of
+// AnnotationValidator::validateComment: the lexer diagnostics and tokens
+// (all offsets relative to the comment start) and the pre-parsed annotation
+// bodies. Entries are keyed by the content hash of the comment text and
+// confirmed by comparing the text, so a header comment seen by many
+// translation units is lexed once and only re-based to each caller's
+// location. Safe for concurrent use. Validators sharing a cache must use
+// equivalent attribute parsers.
+class ValidationCache {
+public:
+    struct Entry {
+        std::string text;
+        AnnotationLexResult lexed;
+        std::vector<nlohmann::json> parsedContents;  // One per lexed token
+    };
+
+    // Counts a hit or a miss.
+    std::shared_ptr<const Entry> find(std::string_view text) const;
+
+    // Returns the stored entry; if another thread inserted the same text
+    // first, that entry wins.
+    std::shared_ptr<const Entry> insert(Entry entry);
+
+    std::size_t size() const;
+    std::size_t hits() const noexcept { return hits_.load(); }
+    std::size_t misses() const noexcept { return misses_.load(); }
+
+private:
+    std::shared_ptr<const Entry> findLocked(std::uint64_t digest, std::string_view text) const;
+
+    mutable std::shared_mutex mutex_;
+    std::unordered_multimap<std::uint64_t, std::shared_ptr<const Entry>> entries_;
+    mutable std::atomic<std::size_t> hits_{0};
+    mutable std::atomic<std::size_t> misses_{0};
+};
+
+} // namespace dsannotation::parsing
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "nlohmann/json.hpp"
+#include "dsannotation/core/Component.h"
+
+namespace dsannotation::serialization {
+
+// Canonical manifest order: components sorted by implementation-class and
+// each component's references by name; ties keep their relative order.
+// Object members are always written in key order, so a canonically ordered
+// manifest depends only on its contents, not on the order in which
+// translation units, fragments or manifests were processed.
+
+// The implementation-class / name JsonManifestBuilder emits for a component
+// or reference, i.e. including overrides from attributes or properties.
+nlohmann::json canonicalKey(const core::Component& component);
+nlohmann::json canonicalKey(const core::Reference& reference);
+
+// Reorders scr.components and their references arrays in place. Entries
+// without the key sort first.
+void sortManifest(nlohmann::json& manifest);
+
+} // namespace dsannotation::serialization
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <optional>
+
+#include "dsannotation/core/Component.h"
+#include "nlohmann/json.hpp"
+
+namespace dsannotation::serialization {
+
+// Lossless JSON form of core::Component, used for intermediate results
+// (scan cache entries). Unlike the manifest layout it keeps interfaces,
+// attributes and references apart so components can be rebuilt exactly.
+nlohmann::json encodeComponent(const core::Component& component);
+std::optional<core::Component> decodeComponent(const nlohmann::json& json);
+
+nlohmann::json encodeComponents(const core::ComponentList& components);
+std::optional<core::ComponentList> decodeComponents(const nlohmann::json& json);
+
+} // namespace dsannotation::serialization
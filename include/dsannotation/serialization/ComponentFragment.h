@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "dsannotation/core/Component.h"
+
+namespace dsannotation::serialization {
+
+// Binary per-translation-unit result, written next to a scan so that large
+// runs can spill to disk and be reduced without re-parsing text JSON.
+//
+// Layout (integers little-endian):
+//   0  magic "DSFRAG\r\n" (the line ending detects newline translation)
+//   8  u32 format version
+//  12  u32 reserved, zero
+//  16  u64 source fingerprint: content hash of the main file when scanned
+//  24  u64 ordinal of the source in the unsharded source list
+//  32  u64 run identity (see tooling::runIdentity)
+//  40  u32 shard index
+//  44  u32 shard count
+//  48  u64 payload size
+//  56  payload: CBOR of {"source": path, "components": encodeComponents(...)}
+struct ComponentFragment {
+    std::string sourcePath;
+    std::uint64_t sourceFingerprint{0};
+    std::uint64_t ordinal{0};
+    std::uint64_t runIdentity{0};
+    std::uint32_t shardIndex{0};
+    std::uint32_t shardCount{1};
+    core::ComponentList components;
+};
+
+inline constexpr std::uint32_t kFragmentFormatVersion = 3;
+inline constexpr std::string_view kFragmentExtension = ".dsfrag";
+
+std::string encodeFragment(const ComponentFragment& fragment);
+
+// Empty for foreign data, other format versions and truncated or
+// malformed payloads.
+std::optional<ComponentFragment> decodeFragment(std::string_view bytes);
+
+// Memory-maps the file and decodes it.
+std::optional<ComponentFragment> readFragment(const std::string& path);
+
+} // namespace dsannotation::serialization
@@ -11,6 +11,8 @@ class IManifestWriter {
 public:
     virtual ~IManifestWriter() = default;
 
+    // The value is false when the output file already had the generated
+    // contents and was left untouched.
     virtual core::Result<bool> writeManifest(const core::ComponentList& components,
                                              const std::string& existingManifestPath,
                                              const std::string& outputPath) const = 0;
@@ -7,12 +7,15 @@
 
 namespace dsannotation::serialization {
 
+// Builds the manifest, merges it into the existing one and writes it; with
+// `canonicalOrder` the merged manifest is sorted by sortManifest first.
 class JsonManifestWriter final : public IManifestWriter {
 public:
     JsonManifestWriter(const IManifestBuilder& builder,
                        const IManifestMerger& merger,
                        const support::IFileSystem& fileSystem,
-                       int indentation = 4);
+                       int indentation = 4,
+                       bool canonicalOrder = false);
 
     core::Result<bool> writeManifest(const core::ComponentList& components,
                                      const std::string& existingManifestPath,
@@ -23,6 +26,7 @@ private:
     const IManifestMerger& merger_;
     const support::IFileSystem& fileSystem_;
     int indentation_;
+    bool canonicalOrder_;
 };
 
 } // namespace dsannotation::serialization
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+
+#include "nlohmann/json.hpp"
+
+namespace dsannotation::serialization {
+
+// Folds manifests into one, a document at a time, with ManifestMerger's
+// semantics: the first non-empty document is the base and keeps all of its
+// content; every later document only contributes its scr.components, each
+// of which updates (json::update) the first entry with the same
+// implementation-class or is appended. The implementation-class index is
+// kept between documents, so folding N documents costs O(total components)
+// and only the merged result stays in memory.
+class ManifestAccumulator {
+public:
+    void add(nlohmann::json manifest);
+
+    const nlohmann::json& manifest() const noexcept { return manifest_; }
+    nlohmann::json release();
+
+private:
+    void mergeComponents(nlohmann::json& target, const nlohmann::json& source);
+
+    nlohmann::json manifest_;
+    // implementation-class -> position in manifest_["scr"]["components"]
+    std::unordered_map<std::string, std::size_t> positions_;
+    std::size_t indexed_{0};
+};
+
+} // namespace dsannotation::serialization
@@ -16,7 +16,6 @@ public:
 
 private:
     nlohmann::json readExistingManifest(const std::string& path) const;
-    void mergeComponents(nlohmann::json& target, const nlohmann::json& source) const;
 
     const support::IFileSystem& fileSystem_;
 };
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <ostream>
+
+#include "dsannotation/core/Component.h"
+
+namespace dsannotation::serialization {
+
+// Writes the manifest of a component list straight to a stream. The output
+// is byte-identical to JsonManifestBuilder::buildManifest(components)
+// .dump(indentation), but only one component's small derived values (the
+// service object and the references) exist as JSON at a time; attributes
+// and properties are serialized in place. An indentation of -1 writes
+// compact JSON. With `canonicalOrder` the output matches the built manifest
+// after sortManifest (see CanonicalOrder.h); the list itself is not copied.
+class StreamingManifestSerializer {
+public:
+    explicit StreamingManifestSerializer(int indentation = 4, bool canonicalOrder = false);
+
+    void write(std::ostream& output, const core::ComponentList& components) const;
+
+private:
+    class Writer;
+
+    int indentation_;
+    bool canonicalOrder_;
+};
+
+} // namespace dsannotation::serialization
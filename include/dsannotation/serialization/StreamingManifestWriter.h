@@ -0,0 +1,36 @@
+#pragma once
+
+#include "dsannotation/serialization/IManifestBuilder.h"
+#include "dsannotation/serialization/IManifestMerger.h"
+#include "dsannotation/serialization/IManifestWriter.h"
+#include "dsannotation/serialization/StreamingManifestSerializer.h"
+#include "dsannotation/support/IFileSystem.h"
+
+namespace dsannotation::serialization {
+
+// Streams a freshly generated manifest to the output file without building
+// the document. Merging with an existing manifest needs the document, so
+// that case is delegated to JsonManifestWriter with the given builder and
+// merger; both paths produce the same bytes.
+class StreamingManifestWriter final : public IManifestWriter {
+public:
+    StreamingManifestWriter(const IManifestBuilder& builder,
+                            const IManifestMerger& merger,
+                            const support::IFileSystem& fileSystem,
+                            int indentation = 4,
+                            bool canonicalOrder = false);
+
+    core::Result<bool> writeManifest(const core::ComponentList& components,
+                                     const std::string& existingManifestPath,
+                                     const std::string& outputPath) const override;
+
+private:
+    const IManifestBuilder& builder_;
+    const IManifestMerger& merger_;
+    const support::IFileSystem& fileSystem_;
+    int indentation_;
+    bool canonicalOrder_;
+    StreamingManifestSerializer serializer_;
+};
+
+} // namespace dsannotation::serialization
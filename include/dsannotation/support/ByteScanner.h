@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace dsannotation::support {
+
+// Vectorized search for the bytes comment lexing has to look at: the
+// structural characters {}[]()"'\@ and control bytes (0x00-0x1F, 0x7F).
+// Everything else can be skipped in bulk.
+enum class ScanKernel {
+    Scalar,
+    SSE2,  // 16 bytes per compare
+    AVX2   // 32 bytes per compare
+};
+
+constexpr std::size_t kScanBlockSize = 32;
+
+bool isStructuralByte(char c) noexcept;
+
+// Best kernel supported by the running CPU, chosen once.
+ScanKernel activeScanKernel() noexcept;
+bool isScanKernelSupported(ScanKernel kernel) noexcept;
+
+// Bit i is set if block[i] is structural. Reads exactly kScanBlockSize
+// bytes; the kernel must be supported.
+std::uint32_t classifyBlock(const char* block, ScanKernel kernel) noexcept;
+
+// Position of the first structural byte at or after `from`, or text.size().
+std::size_t findStructuralByte(std::string_view text, std::size_t from) noexcept;
+std::size_t findStructuralByte(std::string_view text, std::size_t from, ScanKernel kernel) noexcept;
+
+} // namespace dsannotation::support
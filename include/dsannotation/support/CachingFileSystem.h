@@ -0,0 +1,61 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+
+#include "dsannotation/support/IFileSystem.h"
+
+namespace dsannotation::support {
+
+// Forwards to another file system and keeps parsed JSON files for the rest
+// of the run, so a property file shared by many components and translation
+// units is parsed once. Entries are keyed by the absolute, normalized path
+// and revalidated against the file's modification time and size on every
+// read. Unreadable or invalid files are cached as failures as well.
+// Safe for concurrent use; concurrent first reads of one file parse it once.
+class CachingFileSystem final : public IFileSystem {
+public:
+    explicit CachingFileSystem(const IFileSystem& inner);
+
+    bool exists(const std::string& path) const override;
+    std::optional<std::string> readTextFile(const std::string& path) const override;
+    std::optional<nlohmann::json> readJsonFile(const std::string& path) const override;
+    WriteStatus writeTextFile(const std::string& path, const std::string& contents) const override;
+    WriteStatus writeTextStream(const std::string& path,
+                                const std::function<bool(std::ostream&)>& write) const override;
+    WriteStatus writeBinaryFile(const std::string& path, std::string_view contents) const override;
+
+    std::size_t hits() const noexcept { return hits_.load(); }
+    std::size_t misses() const noexcept { return misses_.load(); }
+
+private:
+    struct Stamp {
+        std::filesystem::file_time_type modified;
+        std::uintmax_t size{0};
+
+        bool operator==(const Stamp& other) const { return modified == other.modified && size == other.size; }
+    };
+
+    struct Slot {
+        std::mutex mutex;
+        std::optional<Stamp> stamp;  // Empty until the first read
+        std::shared_ptr<const nlohmann::json> json;  // Null if the file could not be parsed
+    };
+
+    Slot& slot(const std::string& key) const;
+
+    const IFileSystem& inner_;
+    mutable std::shared_mutex mutex_;
+    mutable std::unordered_map<std::string, std::unique_ptr<Slot>> slots_;
+    mutable std::atomic<std::size_t> hits_{0};
+    mutable std::atomic<std::size_t> misses_{0};
+};
+
+} // namespace dsannotation::support
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace dsannotation::support {
+
+// 64-bit FNV-1a. Stable across platforms and builds, so digests can be
+// persisted (scan cache, fragment headers) and compared between runs.
+class ContentHasher {
+public:
+    ContentHasher& update(std::string_view data) noexcept;
+    ContentHasher& update(std::uint64_t value) noexcept;
+
+    std::uint64_t digest() const noexcept { return state_; }
+
+private:
+    std::uint64_t state_{14695981039346656037ULL};
+};
+
+std::uint64_t hashContent(std::string_view data) noexcept;
+std::string toHex(std::uint64_t digest);
+
+} // namespace dsannotation::support
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <vector>
 
 #include "dsannotation/core/ErrorCollector.h"
 
@@ -9,12 +10,13 @@ namespace dsannotation::support {
 class ErrorReporter {
 public:
     explicit ErrorReporter(const core::ErrorCollector& collector);
+    explicit ErrorReporter(const std::vector<core::Error>& errors);
 
     std::string summary() const;
     void print() const;
 
 private:
-    const core::ErrorCollector& collector_;
+    const std::vector<core::Error>& errors_;
 };
 
 } // namespace dsannotation::support
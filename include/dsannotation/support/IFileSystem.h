@@ -1,12 +1,22 @@
 #pragma once
 
+#include <functional>
 #include <optional>
+#include <ostream>
+#include <sstream>
 #include <string>
+#include <string_view>
 
 #include "nlohmann/json.hpp"
 
 namespace dsannotation::support {
 
+enum class WriteStatus {
+    Written,
+    Unchanged,  // The file already had these contents and was left untouched
+    Failed,
+};
+
 class IFileSystem {
 public:
     virtual ~IFileSystem() = default;
@@ -14,7 +24,25 @@ public:
     virtual bool exists(const std::string& path) const = 0;
     virtual std::optional<std::string> readTextFile(const std::string& path) const = 0;
     virtual std::optional<nlohmann::json> readJsonFile(const std::string& path) const = 0;
-    virtual bool writeTextFile(const std::string& path, const std::string& contents) const = 0;
+    virtual WriteStatus writeTextFile(const std::string& path, const std::string& contents) const = 0;
+
+    // Writes the contents produced by `write`. The default buffers them and
+    // calls writeTextFile; file systems backed by real files stream instead.
+    // Fails if `write` returns false or the stream goes bad.
+    virtual WriteStatus writeTextStream(const std::string& path,
+                                        const std::function<bool(std::ostream&)>& write) const {
+        std::ostringstream buffer;
+        if (!write(buffer) || !buffer) {
+            return WriteStatus::Failed;
+        }
+        return writeTextFile(path, buffer.str());
+    }
+
+    // Writes bytes without newline translation. The default suits file
+    // systems that store text unmodified.
+    virtual WriteStatus writeBinaryFile(const std::string& path, std::string_view contents) const {
+        return writeTextFile(path, std::string(contents));
+    }
 };
 
 } // namespace dsannotation::support
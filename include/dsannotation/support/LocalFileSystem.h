@@ -11,7 +11,10 @@ public:
     bool exists(const std::string& path) const override;
     std::optional<std::string> readTextFile(const std::string& path) const override;
     std::optional<nlohmann::json> readJsonFile(const std::string& path) const override;
-    bool writeTextFile(const std::string& path, const std::string& contents) const override;
+    WriteStatus writeTextFile(const std::string& path, const std::string& contents) const override;
+    WriteStatus writeTextStream(const std::string& path,
+                                const std::function<bool(std::ostream&)>& write) const override;
+    WriteStatus writeBinaryFile(const std::string& path, std::string_view contents) const override;
 };
 
 } // namespace dsannotation::support
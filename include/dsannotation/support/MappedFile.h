@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace dsannotation::support {
+
+// Read-only memory mapping of a whole file. Empty files map to an empty
+// view without creating a mapping.
+class MappedFile {
+public:
+    static std::optional<MappedFile> open(const std::string& path);
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+    ~MappedFile();
+
+    std::string_view contents() const noexcept { return {data_, size_}; }
+
+private:
+    MappedFile() = default;
+    void release() noexcept;
+
+    const char* data_{nullptr};
+    std::size_t size_{0};
+#ifdef _WIN32
+    void* mapping_{nullptr};
+#endif
+};
+
+} // namespace dsannotation::support
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "dsannotation/support/IFileSystem.h"
+
+namespace dsannotation::support {
+
+// Forwards to another file system and remembers every path that was read,
+// so callers can learn which external files a parse depended on.
+class RecordingFileSystem final : public IFileSystem {
+public:
+    explicit RecordingFileSystem(const IFileSystem& inner);
+
+    bool exists(const std::string& path) const override;
+    std::optional<std::string> readTextFile(const std::string& path) const override;
+    std::optional<nlohmann::json> readJsonFile(const std::string& path) const override;
+    WriteStatus writeTextFile(const std::string& path, const std::string& contents) const override;
+    WriteStatus writeTextStream(const std::string& path,
+                                const std::function<bool(std::ostream&)>& write) const override;
+    WriteStatus writeBinaryFile(const std::string& path, std::string_view contents) const override;
+
+    std::vector<std::string> readPaths() const;
+
+    // Number of reads so far; pass it to readPathsSince to learn what a
+    // later step read, including paths an earlier step already read.
+    std::size_t readCount() const;
+    std::vector<std::string> readPathsSince(std::size_t readCount) const;
+
+private:
+    void record(const std::string& path) const;
+
+    const IFileSystem& inner_;
+    mutable std::mutex mutex_;
+    mutable std::vector<std::string> readPaths_;
+    // Every read in order, with repeats
+    mutable std::vector<std::string> readLog_;
+};
+
+} // namespace dsannotation::support
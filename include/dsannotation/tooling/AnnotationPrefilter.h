@@ -0,0 +1,86 @@
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "clang/Tooling/CompilationDatabase.h"
+
+namespace dsannotation::tooling {
+
+// Lexical pre-pass that decides, without invoking Clang, whether a
+// translation unit can contain a component. The main file and every user
+// header reachable through #include directives are memory-mapped and
+// searched for the "@component" marker. Includes are resolved with the
+// -I, -iquote, -isystem, -idirafter, -F, -iframework, -imsvc and
+// /external:I options of the compile command and the CPATH family of
+// environment variables.
+//
+// Computed includes, #include_next, precompiled headers and quoted includes
+// that cannot be resolved count as "may contain". Unless `followSystemHeaders` is set,
+// system headers are not scanned, and an angled include found on none of
+// the modeled paths is assumed to come from the compiler's implicit system
+// directories; with it, system headers are scanned and unresolved angled
+// includes count as "may contain" too.
+class AnnotationPrefilter {
+public:
+    explicit AnnotationPrefilter(bool followSystemHeaders = false);
+
+    bool mayContainComponents(const std::vector<clang::tooling::CompileCommand>& commands) const;
+
+    static bool containsMarker(std::string_view text) noexcept;
+
+private:
+    struct IncludeDirective {
+        std::string name;
+        bool angled{false};
+    };
+
+    struct FileScan {
+        bool hasMarker{false};
+        bool hasComputedInclude{false};
+        bool hasIncludeNext{false};
+        std::vector<IncludeDirective> includes;
+    };
+
+    struct SearchPaths {
+        std::vector<std::string> quoted;
+        std::vector<std::string> angled;
+        std::vector<std::string> system;
+        // Framework directories: <Name/Header.h> is Name.framework/Headers/Header.h
+        std::vector<std::string> frameworks;
+        std::vector<std::string> systemFrameworks;
+        std::vector<std::string> forcedIncludes;
+        bool usesPrecompiledHeader{false};
+        std::string fingerprint;
+    };
+
+    struct ResolvedInclude {
+        std::string path;
+        bool isSystem{false};
+    };
+
+    bool mayContainComponents(const clang::tooling::CompileCommand& command) const;
+    static SearchPaths parseSearchPaths(const clang::tooling::CompileCommand& command);
+    static FileScan scanContents(std::string_view text);
+
+    std::shared_ptr<const FileScan> scanFile(const std::string& path) const;
+    std::optional<ResolvedInclude> resolve(const IncludeDirective& include,
+                                           const std::string& includerDirectory,
+                                           const SearchPaths& paths) const;
+
+    bool followSystemHeaders_;
+    mutable std::mutex mutex_;
+    mutable std::unordered_map<std::string, std::shared_ptr<const FileScan>> scans_;
+    mutable std::unordered_map<std::string, std::optional<ResolvedInclude>> resolutions_;
+    // Files whose whole include closure is known to be marker-free, keyed by
+    // search path fingerprint and path.
+    mutable std::unordered_set<std::string> cleanClosures_;
+};
+
+} // namespace dsannotation::tooling
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <memory>
+
+#include "clang/AST/ASTConsumer.h"
+#include "clang/Frontend/FrontendAction.h"
+#include "clang/Frontend/Utils.h"
+#include "clang/Tooling/Tooling.h"
+
+#include "dsannotation/tooling/ScanResults.h"
+#include "dsannotation/tooling/ScanSession.h"
+
+namespace dsannotation::tooling {
+
+// Parses one translation unit and contributes its components and
+// diagnostics to the run. Serialization happens once per run, after all
+// translation units have been parsed.
+class ComponentASTConsumer : public clang::ASTConsumer {
+public:
+    ComponentASTConsumer(const ScanSession& session,
+                         TranslationUnitResult& result,
+                         std::shared_ptr<clang::DependencyCollector> dependencies);
+
+    void HandleTranslationUnit(clang::ASTContext& context) override;
+
+private:
+    const ScanSession& session_;
+    TranslationUnitResult& result_;
+    std::shared_ptr<clang::DependencyCollector> dependencies_;
+};
+
+class ComponentAction : public clang::ASTFrontendAction {
+public:
+    ComponentAction(const ScanSession& session, TranslationUnitResult& result);
+
+    bool BeginInvocation(clang::CompilerInstance& CI) override;
+
+    std::unique_ptr<clang::ASTConsumer> CreateASTConsumer(clang::CompilerInstance& CI,
+                                                          llvm::StringRef inFile) override;
+
+private:
+    const ScanSession& session_;
+    TranslationUnitResult& result_;
+};
+
+class ComponentActionFactory : public clang::tooling::FrontendActionFactory {
+public:
+    ComponentActionFactory(const ScanSession& session, TranslationUnitResult& result);
+
+    std::unique_ptr<clang::FrontendAction> create() override;
+
+private:
+    const ScanSession& session_;
+    TranslationUnitResult& result_;
+};
+
+} // namespace dsannotation::tooling
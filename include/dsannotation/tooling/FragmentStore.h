@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "dsannotation/config/ParserConfig.h"
+#include "dsannotation/support/IFileSystem.h"
+#include "dsannotation/tooling/ScanResults.h"
+
+namespace dsannotation::tooling {
+
+// Writes each translation unit's components as a binary fragment (see
+// serialization::ComponentFragment) into a directory. Fragments are named
+// after the hash of the source path, so a rescan replaces its own fragment.
+// The source fingerprint is the content hash of the main file. Every
+// fragment records the run and shard that wrote it, so a merge can reject
+// fragments left by another run.
+class FragmentStore {
+public:
+    FragmentStore(std::string directory,
+                  const support::IFileSystem& fileSystem,
+                  std::uint64_t runIdentity,
+                  config::ShardSpec shard);
+
+    // Returns false, without throwing, if the source could not be read or
+    // the fragment could not be written.
+    bool store(const TranslationUnitResult& result) const;
+
+    std::string fragmentPath(const std::string& sourcePath) const;
+
+private:
+    bool storeFragment(const TranslationUnitResult& result) const;
+
+    std::string directory_;
+    const support::IFileSystem& fileSystem_;
+    std::uint64_t runIdentity_;
+    config::ShardSpec shard_;
+};
+
+} // namespace dsannotation::tooling
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+#include "dsannotation/support/IFileSystem.h"
+#include "dsannotation/tooling/ScanResults.h"
+
+namespace dsannotation::tooling {
+
+// On-disk cache of per-translation-unit scan results. An entry is keyed by
+// the source path and records the compile command fingerprint plus the
+// content hash of every dependency (main file, user headers, @property
+// files). A lookup only hits when all of them are unchanged.
+class ScanCache {
+public:
+    ScanCache(std::string directory, const support::IFileSystem& fileSystem);
+
+    // Missing, stale and malformed entries are misses.
+    std::optional<TranslationUnitResult> lookup(const std::string& sourcePath,
+                                                std::uint64_t commandFingerprint) const;
+
+    // Dependencies must be absolute paths. Returns false, without throwing,
+    // if the entry could not be written.
+    bool store(const TranslationUnitResult& result, std::uint64_t commandFingerprint) const;
+
+private:
+    std::optional<TranslationUnitResult> decodeEntry(const std::string& sourcePath,
+                                                     std::uint64_t commandFingerprint) const;
+    bool storeEntry(const TranslationUnitResult& result, std::uint64_t commandFingerprint) const;
+
+    std::string entryPath(const std::string& sourcePath) const;
+    std::optional<std::uint64_t> contentHash(const std::string& path) const;
+
+    std::string directory_;
+    const support::IFileSystem& fileSystem_;
+
+    // Dependency hashes are memoized for the lifetime of the run; headers
+    // shared by many translation units are hashed once.
+    mutable std::mutex mutex_;
+    mutable std::unordered_map<std::string, std::optional<std::uint64_t>> hashes_;
+};
+
+} // namespace dsannotation::tooling
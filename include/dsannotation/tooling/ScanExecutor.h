@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "clang/Tooling/CompilationDatabase.h"
+
+#include "dsannotation/tooling/ScanResults.h"
+#include "dsannotation/tooling/ScanSession.h"
+
+namespace dsannotation::tooling {
+
+// Runs ComponentAction over a list of translation units on a pool of worker
+// threads. Workers pull the next unparsed source from a shared counter and
+// parse it with their own ClangTool, so results land in the slot of the
+// source they belong to regardless of completion order. Translation units
+// rejected by the session's prefilter are skipped and unchanged ones are
+// served from the session's cache, both without invoking Clang. With a
+// fragment store every translation unit's components are also spilled to
+// disk.
+class ScanExecutor {
+public:
+    ScanExecutor(const clang::tooling::CompilationDatabase& compilations,
+                 const ScanSession& session,
+                 unsigned jobs);
+
+    // Returns the ClangTool status: 0 on success, non-zero if any
+    // translation unit failed to parse.
+    int run(const std::vector<std::string>& sourcePaths, ScanResults& results) const;
+
+private:
+    int scanTranslationUnit(const std::string& sourcePath,
+                            TranslationUnitResult& result,
+                            ScanStatistics& statistics) const;
+    int collectResult(const std::string& sourcePath,
+                      const std::vector<clang::tooling::CompileCommand>& commands,
+                      std::uint64_t fingerprint,
+                      TranslationUnitResult& result,
+                      ScanStatistics& statistics) const;
+
+    const clang::tooling::CompilationDatabase& compilations_;
+    const ScanSession& session_;
+    unsigned jobs_;
+};
+
+} // namespace dsannotation::tooling
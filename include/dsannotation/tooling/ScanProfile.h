@@ -0,0 +1,26 @@
+#pragma once
+
+#include <string_view>
+
+#include "clang/Tooling/ArgumentsAdjusters.h"
+
+namespace dsannotation::tooling {
+
+// Whether `driver`, the first argument of a compile command, is cl or
+// clang-cl and therefore takes cl-style options such as /I and /O2.
+bool isMsvcDriver(std::string_view driver);
+
+// Command line adjustments for config::ScanProfile::Declarations. Forces
+// -fsyntax-only, drops warning, optimization, debug-info and code
+// generation flags that cannot influence class declarations (including
+// their cl spellings for cl-style drivers), and silences warnings with -w.
+// Forwarded flags (-Xclang <flag>) are judged by their value and kept or
+// dropped together with it. The driver, option values, `filename` and
+// everything after "--" are kept as they are.
+clang::tooling::CommandLineArguments adjustForDeclarationScan(const clang::tooling::CommandLineArguments& arguments,
+                                                              std::string_view filename);
+
+// adjustForDeclarationScan as an adjuster for ClangTool.
+clang::tooling::ArgumentsAdjuster getDeclarationScanAdjuster();
+
+} // namespace dsannotation::tooling
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "dsannotation/core/Component.h"
+#include "dsannotation/core/Error.h"
+
+namespace dsannotation::tooling {
+
+struct TranslationUnitResult {
+    std::string sourcePath;
+    // Position of the source in the unsharded source list; orders the
+    // fragments of all shards like a single run.
+    std::size_t ordinal{0};
+    core::ComponentList components;
+    std::vector<core::Error> errors;
+    // Main file, user headers and external property files the result was
+    // derived from, as absolute paths.
+    std::vector<std::string> dependencies;
+    // Interface-name resolutions of constructor parameters; diagnostics
+    // only, not persisted in the scan cache.
+    std::size_t interfaceNameLookups{0};
+    std::size_t interfaceNameHits{0};
+};
+
+struct ScanStatistics {
+    std::atomic<std::size_t> translationUnitsParsed{0};
+    std::atomic<std::size_t> translationUnitsSkipped{0};
+    std::atomic<std::size_t> cacheHits{0};
+    std::atomic<std::size_t> cacheMisses{0};
+    std::atomic<std::size_t> interfaceNameLookups{0};
+    std::atomic<std::size_t> interfaceNameHits{0};
+
+    std::string summary() const;
+};
+
+// One slot per source file. Every slot is written by exactly one worker, so
+// the slots themselves need no locking; aggregation happens after all
+// workers have joined.
+class ScanResults {
+public:
+    // `ordinals` defaults to the position in `sourcePaths`.
+    explicit ScanResults(const std::vector<std::string>& sourcePaths,
+                         const std::vector<std::size_t>& ordinals = {});
+
+    TranslationUnitResult& slot(std::size_t index) { return slots_[index]; }
+    const std::vector<TranslationUnitResult>& translationUnits() const noexcept { return slots_; }
+
+    // Components of all translation units in source (ordinal) order.
+    // Header-declared components seen by several translation units are kept
+    // once, at their first occurrence, so conflicting definitions are
+    // settled by source order rather than by which worker finished first.
+    core::ComponentList components() const;
+    // Diagnostics in source order, each reported once, followed by one
+    // error per definition that conflicts with the kept one.
+    std::vector<core::Error> errors() const;
+
+    ScanStatistics& statistics() noexcept { return statistics_; }
+    const ScanStatistics& statistics() const noexcept { return statistics_; }
+
+private:
+    std::vector<const TranslationUnitResult*> inSourceOrder() const;
+
+    std::vector<TranslationUnitResult> slots_;
+    ScanStatistics statistics_;
+};
+
+} // namespace dsannotation::tooling
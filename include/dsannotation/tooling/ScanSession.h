@@ -0,0 +1,28 @@
+#pragma once
+
+#include "dsannotation/config/ParserConfig.h"
+#include "dsannotation/parsing/ComponentRegistry.h"
+#include "dsannotation/parsing/ValidationCache.h"
+#include "dsannotation/support/IFileSystem.h"
+
+namespace dsannotation::tooling {
+
+class AnnotationPrefilter;
+class FragmentStore;
+class ScanCache;
+
+// Run-wide state shared by every translation unit of a scan. Optional
+// services are null when disabled.
+struct ScanSession {
+    const config::ParserConfig& config;
+    parsing::ComponentRegistry* registry{nullptr};
+    const ScanCache* cache{nullptr};
+    const AnnotationPrefilter* prefilter{nullptr};
+    parsing::ValidationCache* validationCache{nullptr};
+    // File system for @property files; a run-wide caching decorator lets
+    // translation units share parsed files. Null reads the disk directly.
+    const support::IFileSystem* propertyFileSystem{nullptr};
+    const FragmentStore* fragments{nullptr};
+};
+
+} // namespace dsannotation::tooling
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "dsannotation/config/ParserConfig.h"
+
+namespace dsannotation::tooling {
+
+// Parses "i/N" with N > 0 and i < N.
+std::optional<config::ShardSpec> parseShardSpec(std::string_view text);
+
+// The key a source is partitioned by: its path relative to `rootDirectory`
+// (the working directory of its compile command) with '/' separators, so
+// nodes that check out the tree in different places agree on it. A source
+// that cannot be expressed relative to the root keeps its normalized path.
+std::string partitionKey(const std::string& sourcePath, const std::string& rootDirectory);
+
+// Positions in `partitionKeys` of the sources that belong to `shard`, in
+// source order. A source's shard depends only on the content hash of its
+// key, so every node computes the same partition and the shards together
+// cover each source exactly once.
+std::vector<std::size_t> selectShard(const std::vector<std::string>& partitionKeys, const config::ShardSpec& shard);
+
+// Identifies a run over the ordered source list; fragments record it so a
+// merge can refuse to combine shards of different runs.
+std::uint64_t runIdentity(const std::vector<std::string>& partitionKeys);
+
+} // namespace dsannotation::tooling
@@ -4,6 +4,8 @@
 #include "clang/Basic/SourceManager.h"
 #include "llvm/Support/raw_ostream.h"
 
+#include <utility>
+
 namespace dsannotation::core {
 
 ErrorCollector::ErrorCollector(const clang::SourceManager& sourceManager)
@@ -33,6 +35,10 @@ void ErrorCollector::addError(std::string message,
     errors_.push_back(Error{std::move(message), std::string{}, severity, category});
 }
 
+void ErrorCollector::addError(Error error) {
+    errors_.push_back(std::move(error));
+}
+
 std::string ErrorCollector::formatLocation(clang::SourceLocation location) const {
     if (!location.isValid()) {
         return "<invalid>";
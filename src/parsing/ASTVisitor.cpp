@@ -1,35 +1,58 @@
 #include "dsannotation/parsing/ASTVisitor.h"
 
+#include "clang/AST/DeclTemplate.h"
+
 namespace dsannotation::parsing {
 
-ASTVisitor::ASTVisitor(clang::ASTContext& context, const IComponentParser& componentParser)
-    : context_(context), componentParser_(componentParser) {}
+namespace {
+// Declarations that are, or can lexically contain, component classes.
+bool canContainComponents(const clang::Decl& declaration) {
+    return llvm::isa<clang::TranslationUnitDecl>(declaration) ||
+           llvm::isa<clang::NamespaceDecl>(declaration) ||
+           llvm::isa<clang::LinkageSpecDecl>(declaration) ||
+           llvm::isa<clang::ExportDecl>(declaration) ||
+           llvm::isa<clang::CXXRecordDecl>(declaration) ||
+           llvm::isa<clang::ClassTemplateDecl>(declaration);
+}
+} // namespace
+
+ASTVisitor::ASTVisitor(ComponentCollector& collector, TraversalScope scope, LocationFilter* filter)
+    : collector_(collector), scope_(scope), filter_(filter && filter->isActive() ? filter : nullptr) {}
 
 bool ASTVisitor::VisitCXXRecordDecl(clang::CXXRecordDecl* declaration) {
-    if (!declaration || !declaration->hasDefinition()) {
-        return true;
+    if (declaration) {
+        collector_.collect(*declaration);
     }
+    return true;
+}
 
-    const auto* rawComment = context_.getRawCommentForDeclNoCache(declaration);
-    if (!rawComment) {
+bool ASTVisitor::TraverseDecl(clang::Decl* declaration) {
+    if (!declaration) {
+        return true;
+    }
+    if (scope_ == TraversalScope::Declarations && !canContainComponents(*declaration)) {
+        return true;
+    }
+    if (filter_ && !llvm::isa<clang::TranslationUnitDecl>(declaration) && !filter_->accepts(*declaration)) {
         return true;
     }
+    return Base::TraverseDecl(declaration);
+}
 
-    auto commentText = rawComment->getRawText(context_.getSourceManager());
-    if (!commentText.contains("@component")) {
+bool ASTVisitor::TraverseStmt(clang::Stmt* statement, DataRecursionQueue* queue) {
+    if (scope_ == TraversalScope::Declarations) {
         return true;
     }
+    return Base::TraverseStmt(statement, queue);
+}
 
-    auto component = componentParser_.parse(*declaration, context_);
-    
-    // Only add components that were successfully parsed
-    // Invalid components (due to malformed annotations) will have empty class names
-    if (!component.className().empty()) {
-        components_.push_back(std::move(component));
+bool ASTVisitor::TraverseTypeLoc(clang::TypeLoc typeLoc) {
+    // Base specifiers and template arguments are spelled as types; classes
+    // defined inside them are also members of the enclosing DeclContext.
+    if (scope_ == TraversalScope::Declarations) {
+        return true;
     }
-    // Note: Validation errors are already reported by ComponentParser
-    
-    return true;
+    return Base::TraverseTypeLoc(typeLoc);
 }
 
 } // namespace dsannotation::parsing
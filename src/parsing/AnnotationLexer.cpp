@@ -0,0 +1,254 @@
+#include "dsannotation/parsing/AnnotationLexer.h"
+
+#include "dsannotation/support/ByteScanner.h"
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <string>
+
+namespace dsannotation::parsing {
+
+namespace {
+
+constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+struct Keyword {
+    std::string_view text;
+    AnnotationType type;
+};
+
+// In the order annotations are reported.
+constexpr std::array<Keyword, 4> keywords{{
+    {"@component", AnnotationType::Component},
+    {"@properties", AnnotationType::Properties},
+    {"@property", AnnotationType::Property},
+    {"@reference", AnnotationType::Reference},
+}};
+
+bool isAlnum(char c) {
+    return std::isalnum(static_cast<unsigned char>(c)) != 0;
+}
+
+ValidationError makeError(std::string message, core::ErrorSeverity severity, std::size_t position = 0) {
+    ValidationError error;
+    error.message = std::move(message);
+    error.severity = severity;
+    error.position = position;
+    return error;
+}
+
+struct OpenBrace {
+    char brace;
+    std::size_t position;
+};
+
+struct OpenCurly {
+    std::size_t token;  // Annotation whose body this brace opens, or npos
+};
+
+struct BodyRequest {
+    std::size_t bracePosition;
+    std::size_t token;
+};
+
+} // namespace
+
+support::SourceLocationInfo AnnotationToken::locate(const support::SourceLocationInfo& base) const {
+    if (lineOffset == 0) {
+        return support::SourceLocationInfo(base.filename, base.line,
+                                           base.column + static_cast<unsigned int>(columnOffset));
+    }
+    return support::SourceLocationInfo(base.filename, base.line + lineOffset,
+                                       1 + static_cast<unsigned int>(columnOffset));
+}
+
+std::string_view AnnotationToken::content(std::string_view text) const {
+    if (!isValid || contentBegin >= contentEnd) {
+        return {};
+    }
+    return text.substr(contentBegin, contentEnd - contentBegin);
+}
+
+AnnotationLexResult AnnotationLexer::lex(std::string_view text, std::size_t maxLength) {
+    AnnotationLexResult result;
+    std::vector<ValidationError> braceErrors;
+
+    if (text.size() > maxLength) {
+        result.syntaxErrors.push_back(makeError("Comment exceeds maximum length of " + std::to_string(maxLength) +
+                                                    " characters",
+                                                core::ErrorSeverity::Error));
+        result.syntaxValid = false;
+    }
+
+    std::vector<OpenBrace> braces;          // (), [] and {} for the balance check
+    std::vector<OpenCurly> curlies;         // {} only, for annotation bodies
+    std::vector<BodyRequest> bodyRequests;  // '{' positions annotations wait for, ascending
+    std::vector<std::size_t> sharedBodies;  // (token, owner) pairs for annotations sharing a body
+    std::size_t nextRequest = 0;
+
+    bool inSingleQuote = false;
+    bool inDoubleQuote = false;
+    std::size_t backslashes = 0;
+    unsigned line = 0;
+    std::size_t lineStart = 0;
+
+    // Only structural bytes ({}[]()"'\@ and control characters) affect the
+    // state; the vectorized scanner skips everything in between.
+    std::size_t previous = npos;
+    for (std::size_t i = support::findStructuralByte(text, 0); i < text.size();
+         previous = i, i = support::findStructuralByte(text, i + 1)) {
+        const char c = text[i];
+        if (i != previous + 1) {
+            // Skipped bytes end any run of backslashes
+            backslashes = 0;
+        }
+
+        if (c == '\0') {
+            result.syntaxErrors.push_back(makeError("Null character found at position " + std::to_string(i),
+                                                    core::ErrorSeverity::Error, i));
+            result.syntaxValid = false;
+        }
+        if (std::iscntrl(static_cast<unsigned char>(c)) && c != '\n' && c != '\t' && c != '\r') {
+            result.syntaxErrors.push_back(makeError("Invalid control character found at position " +
+                                                        std::to_string(i),
+                                                    core::ErrorSeverity::Warning, i));
+        }
+
+        switch (c) {
+        case '{':
+        case '[':
+        case '(':
+            braces.push_back({c, i});
+            if (c == '{') {
+                std::size_t token = npos;
+                if (nextRequest < bodyRequests.size() && bodyRequests[nextRequest].bracePosition == i) {
+                    token = bodyRequests[nextRequest++].token;
+                }
+                curlies.push_back({token});
+            }
+            break;
+        case '}':
+        case ']':
+        case ')':
+            if (braces.empty()) {
+                braceErrors.push_back(makeError("Unmatched closing brace '" + std::string(1, c) +
+                                                    "' at position " + std::to_string(i),
+                                                core::ErrorSeverity::Error, i));
+            } else {
+                const char open = braces.back().brace;
+                braces.pop_back();
+                const bool matches = (open == '{' && c == '}') || (open == '[' && c == ']') ||
+                                     (open == '(' && c == ')');
+                if (!matches) {
+                    braceErrors.push_back(makeError("Mismatched braces: '" + std::string(1, open) + "' and '" +
+                                                        std::string(1, c) + "'",
+                                                    core::ErrorSeverity::Error, i));
+                }
+            }
+            if (c == '}' && !curlies.empty()) {
+                const auto token = curlies.back().token;
+                curlies.pop_back();
+                if (token != npos) {
+                    result.annotations[token].contentEnd = i;
+                    result.annotations[token].isValid = true;
+                }
+            }
+            break;
+        case '"':
+            if (!inSingleQuote && backslashes % 2 == 0) {
+                inDoubleQuote = !inDoubleQuote;
+            }
+            break;
+        case '\'':
+            if (!inDoubleQuote && backslashes % 2 == 0) {
+                inSingleQuote = !inSingleQuote;
+            }
+            break;
+        case '@':
+            for (const auto& keyword : keywords) {
+                if (text.compare(i, keyword.text.size(), keyword.text) != 0) {
+                    continue;
+                }
+
+                const std::size_t end = i + keyword.text.size();
+                AnnotationToken token;
+                token.type = keyword.type;
+                token.position = i;
+                token.lineOffset = line;
+                token.columnOffset = line == 0 ? i : i - lineStart;
+                token.wordBoundary = (i == 0 || !isAlnum(text[i - 1])) && (end >= text.size() || !isAlnum(text[end]));
+
+                if (token.wordBoundary) {
+                    // The annotation name runs over letters, digits and '@';
+                    // a '{' after optional whitespace opens its body.
+                    std::size_t cursor = end;
+                    while (cursor < text.size() && (isAlnum(text[cursor]) || text[cursor] == '@')) {
+                        ++cursor;
+                    }
+                    while (cursor < text.size() && std::isspace(static_cast<unsigned char>(text[cursor]))) {
+                        ++cursor;
+                    }
+                    if (cursor < text.size() && text[cursor] == '{') {
+                        token.contentBegin = cursor + 1;
+                        if (nextRequest < bodyRequests.size() && bodyRequests.back().bracePosition == cursor) {
+                            // Another annotation inside the same name run, e.g. '@component@@property {'
+                            sharedBodies.push_back(result.annotations.size());
+                            sharedBodies.push_back(bodyRequests.back().token);
+                        } else {
+                            bodyRequests.push_back({cursor, result.annotations.size()});
+                        }
+                    } else {
+                        token.isValid = true;
+                    }
+                }
+
+                result.annotations.push_back(token);
+                break;
+            }
+            break;
+        default:
+            break;
+        }
+
+        backslashes = c == '\\' ? backslashes + 1 : 0;
+        if (c == '\n') {
+            ++line;
+            lineStart = i + 1;
+        }
+    }
+
+    while (!braces.empty()) {
+        braceErrors.push_back(makeError("Unclosed brace '" + std::string(1, braces.back().brace) + "'",
+                                        core::ErrorSeverity::Error, braces.back().position));
+        braces.pop_back();
+    }
+    if (!braceErrors.empty()) {
+        result.syntaxValid = false;
+        result.syntaxErrors.insert(result.syntaxErrors.end(), braceErrors.begin(), braceErrors.end());
+    }
+
+    if (inDoubleQuote || inSingleQuote) {
+        result.syntaxErrors.push_back(makeError("Unclosed quote in comment", core::ErrorSeverity::Error));
+        result.syntaxValid = false;
+    }
+
+    for (std::size_t i = 0; i < sharedBodies.size(); i += 2) {
+        const auto& owner = result.annotations[sharedBodies[i + 1]];
+        auto& token = result.annotations[sharedBodies[i]];
+        token.contentEnd = owner.contentEnd;
+        token.isValid = owner.isValid;
+    }
+
+    std::stable_sort(result.annotations.begin(), result.annotations.end(),
+                     [](const AnnotationToken& lhs, const AnnotationToken& rhs) {
+                         if (lhs.type != rhs.type) {
+                             return lhs.type < rhs.type;
+                         }
+                         return lhs.wordBoundary && !rhs.wordBoundary;
+                     });
+
+    return result;
+}
+
+} // namespace dsannotation::parsing
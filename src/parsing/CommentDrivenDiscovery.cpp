@@ -0,0 +1,156 @@
+#include "dsannotation/parsing/CommentDrivenDiscovery.h"
+
+#include "clang/AST/DeclCXX.h"
+#include "clang/AST/DeclTemplate.h"
+#include "clang/AST/RawCommentList.h"
+#include "clang/Basic/SourceManager.h"
+
+#include <algorithm>
+
+namespace dsannotation::parsing {
+
+namespace {
+
+// True if a sorted offset list has an entry in [first, last).
+bool containsOffsetIn(const std::vector<unsigned>& offsets, unsigned first, unsigned last) {
+    auto it = std::lower_bound(offsets.begin(), offsets.end(), first);
+    return it != offsets.end() && *it < last;
+}
+
+void sortUnique(std::vector<unsigned>& offsets) {
+    std::sort(offsets.begin(), offsets.end());
+    offsets.erase(std::unique(offsets.begin(), offsets.end()), offsets.end());
+}
+
+// Record a class template's comment is attached to, or null.
+clang::CXXRecordDecl* recordOf(clang::Decl& declaration) {
+    if (auto* classTemplate = llvm::dyn_cast<clang::ClassTemplateDecl>(&declaration)) {
+        return classTemplate->getTemplatedDecl();
+    }
+    return llvm::dyn_cast<clang::CXXRecordDecl>(&declaration);
+}
+
+// Declaration contexts that may lexically contain component classes.
+const clang::DeclContext* nestedContextOf(clang::Decl& declaration) {
+    if (llvm::isa<clang::NamespaceDecl>(declaration) || llvm::isa<clang::LinkageSpecDecl>(declaration) ||
+        llvm::isa<clang::ExportDecl>(declaration)) {
+        return llvm::cast<clang::DeclContext>(&declaration);
+    }
+    auto* record = recordOf(declaration);
+    if (record && record->isThisDeclarationADefinition()) {
+        return record;
+    }
+    return nullptr;
+}
+
+} // namespace
+
+CommentDrivenDiscovery::CommentDrivenDiscovery(clang::ASTContext& context,
+                                               ComponentCollector& collector,
+                                               LocationFilter* filter)
+    : context_(context), collector_(collector), filter_(filter && filter->isActive() ? filter : nullptr) {}
+
+void CommentDrivenDiscovery::discover() {
+    if (context_.getExternalSource()) {
+        // Comments of a precompiled preamble are loaded lazily and are not
+        // visible through the comment list; visit declarations instead.
+        walkAll_ = true;
+    } else if (!indexAnnotatedComments()) {
+        return;
+    }
+    walk(*context_.getTranslationUnitDecl());
+}
+
+bool CommentDrivenDiscovery::indexAnnotatedComments() {
+    const auto& sourceManager = context_.getSourceManager();
+    const auto& comments = context_.getRawCommentList();
+
+    // Local entry 0 is a placeholder; every file entry is one inclusion.
+    for (unsigned i = 1, e = sourceManager.local_sloc_entry_size(); i != e; ++i) {
+        const auto& entry = sourceManager.getLocalSLocEntry(i);
+        if (!entry.isFile()) {
+            continue;
+        }
+        auto file = sourceManager.getFileID(clang::SourceLocation::getFromRawEncoding(entry.getOffset()));
+        if (filter_ && !filter_->accepts(file)) {
+            continue;
+        }
+        const auto* fileComments = comments.getCommentsInFile(file);
+        if (!fileComments) {
+            continue;
+        }
+
+        std::vector<unsigned> annotated;
+        for (const auto& [offset, comment] : *fileComments) {
+            if (comment->getRawText(sourceManager).contains("@component")) {
+                annotated.push_back(offset);
+            }
+        }
+        if (annotated.empty()) {
+            continue;
+        }
+
+        auto& index = files_[file];
+        index.enclosingOffsets.insert(index.enclosingOffsets.end(), annotated.begin(), annotated.end());
+        index.annotatedComments = std::move(annotated);
+
+        // A namespace in an including file encloses the comment if it
+        // encloses the #include that (transitively) brought the file in.
+        for (auto includeLoc = sourceManager.getIncludeLoc(file); includeLoc.isValid();) {
+            auto [includer, offset] = sourceManager.getDecomposedExpansionLoc(includeLoc);
+            files_[includer].enclosingOffsets.push_back(offset);
+            includeLoc = sourceManager.getIncludeLoc(includer);
+        }
+    }
+
+    for (auto& entry : files_) {
+        sortUnique(entry.second.enclosingOffsets);
+    }
+    return !files_.empty();
+}
+
+const CommentDrivenDiscovery::FileIndex* CommentDrivenDiscovery::fileIndex(clang::FileID file) const {
+    auto it = files_.find(file);
+    return it == files_.end() ? nullptr : &it->second;
+}
+
+void CommentDrivenDiscovery::walk(const clang::DeclContext& declContext) {
+    const auto& sourceManager = context_.getSourceManager();
+
+    clang::FileID previousFile;
+    unsigned previousEnd = 0;
+    for (auto* declaration : declContext.decls()) {
+        if (declaration->isImplicit() || (filter_ && !filter_->accepts(*declaration))) {
+            continue;
+        }
+
+        auto [file, begin] = sourceManager.getDecomposedExpansionLoc(declaration->getBeginLoc());
+        auto [endFile, end] = sourceManager.getDecomposedExpansionLoc(declaration->getEndLoc());
+        const bool singleFile = file.isValid() && file == endFile && begin <= end;
+
+        // Only a comment between the previous sibling and this declaration
+        // can be the declaration's doc comment.
+        const unsigned commentsFrom = file == previousFile ? previousEnd : 0;
+        previousFile = file;
+        previousEnd = singleFile ? end : begin;
+
+        const auto* index = fileIndex(file);
+        if (!walkAll_ && !index && singleFile) {
+            continue;
+        }
+
+        auto* record = recordOf(*declaration);
+        if (record && (walkAll_ || !index ||
+                       containsOffsetIn(index->annotatedComments, commentsFrom, begin))) {
+            collector_.collect(*record);
+        }
+
+        const auto* nested = nestedContextOf(*declaration);
+        if (nested && (walkAll_ || !singleFile ||
+                       containsOffsetIn(index->enclosingOffsets, begin, end + 1))) {
+            walk(*nested);
+        }
+    }
+}
+
+} // namespace dsannotation::parsing
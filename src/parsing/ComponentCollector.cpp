@@ -0,0 +1,127 @@
+#include "dsannotation/parsing/ComponentCollector.h"
+
+#include <cstddef>
+#include <iterator>
+
+#include "clang/Basic/SourceManager.h"
+#include "clang/Index/USRGeneration.h"
+#include "llvm/ADT/SmallString.h"
+
+#include "dsannotation/support/ContentHash.h"
+
+namespace dsannotation::parsing {
+
+namespace {
+// Identity of a class across translation units: its USR, or the spelling
+// file and offset of its definition when no USR can be generated.
+std::string componentKey(const clang::CXXRecordDecl& declaration, const clang::SourceManager& sourceManager) {
+    llvm::SmallString<128> usr;
+    if (!clang::index::generateUSRForDecl(&declaration, usr)) {
+        return usr.str().str();
+    }
+
+    auto location = sourceManager.getExpansionLoc(declaration.getLocation());
+    return sourceManager.getFilename(location).str() + ":" +
+           std::to_string(sourceManager.getFileOffset(location));
+}
+
+// Summary of everything ComponentParser reads from a definition: the class
+// comment, the base classes and the constructor comments and parameter
+// types.
+std::uint64_t definitionFingerprint(const clang::CXXRecordDecl& declaration,
+                                    llvm::StringRef commentText,
+                                    clang::ASTContext& context) {
+    support::ContentHasher hasher;
+    hasher.update(std::string_view(commentText.data(), commentText.size()));
+
+    for (const auto& base : declaration.bases()) {
+        if (const auto* baseDecl = base.getType()->getAsCXXRecordDecl()) {
+            hasher.update(baseDecl->getQualifiedNameAsString()).update(std::string_view("\0", 1));
+        }
+    }
+
+    for (const auto* constructor : declaration.ctors()) {
+        if (const auto* comment = context.getRawCommentForDeclNoCache(constructor)) {
+            auto text = comment->getRawText(context.getSourceManager());
+            hasher.update(std::string_view(text.data(), text.size()));
+        }
+        // Reference interfaces are derived from the parameter types, which
+        // macros and typedefs can make differ between translation units.
+        hasher.update(static_cast<std::uint64_t>(constructor->getNumParams()));
+        for (const auto* param : constructor->parameters()) {
+            hasher.update(param->getType().getCanonicalType().getAsString()).update(std::string_view("\0", 1));
+        }
+    }
+
+    return hasher.digest();
+}
+} // namespace
+
+ComponentCollector::ComponentCollector(clang::ASTContext& context,
+                                       const IComponentParser& componentParser,
+                                       core::ErrorCollector& errorCollector,
+                                       ComponentRegistry* registry,
+                                       const support::RecordingFileSystem* readRecorder)
+    : context_(context),
+      componentParser_(componentParser),
+      errorCollector_(errorCollector),
+      registry_(registry),
+      readRecorder_(readRecorder) {}
+
+void ComponentCollector::collect(clang::CXXRecordDecl& record) {
+    auto* declaration = &record;
+    if (!declaration->hasDefinition()) {
+        return;
+    }
+
+    const auto* rawComment = context_.getRawCommentForDeclNoCache(declaration);
+    if (!rawComment) {
+        return;
+    }
+
+    auto commentText = rawComment->getRawText(context_.getSourceManager());
+    if (!commentText.contains("@component")) {
+        return;
+    }
+
+    std::optional<core::Component> component;
+    if (registry_) {
+        auto resolution = registry_->resolve(
+            componentKey(*declaration, context_.getSourceManager()),
+            definitionFingerprint(*declaration, commentText, context_),
+            [&]() { return parseRecorded(*declaration); });
+        // Conflicting definitions are kept and settled across translation
+        // units after the scan (ScanResults), in source order.
+        for (auto& error : resolution.errors) {
+            errorCollector_.addError(std::move(error));
+        }
+        dependencies_.insert(dependencies_.end(),
+                             std::make_move_iterator(resolution.dependencies.begin()),
+                             std::make_move_iterator(resolution.dependencies.end()));
+        component = std::move(resolution.component);
+    } else {
+        component = componentParser_.parse(*declaration, context_);
+    }
+
+    // Only add components that were successfully parsed
+    // Invalid components (due to malformed annotations) will have empty class names
+    if (component && !component->className().empty()) {
+        components_.push_back(std::move(*component));
+    }
+    // Note: Validation errors are already reported by ComponentParser
+}
+
+ComponentRegistry::Parsed ComponentCollector::parseRecorded(clang::CXXRecordDecl& declaration) {
+    const auto firstError = errorCollector_.errors().size();
+    const auto firstRead = readRecorder_ ? readRecorder_->readCount() : 0;
+
+    ComponentRegistry::Parsed parsed{componentParser_.parse(declaration, context_), {}, {}};
+    const auto& errors = errorCollector_.errors();
+    parsed.errors.assign(errors.begin() + static_cast<std::ptrdiff_t>(firstError), errors.end());
+    if (readRecorder_) {
+        parsed.dependencies = readRecorder_->readPathsSince(firstRead);
+    }
+    return parsed;
+}
+
+} // namespace dsannotation::parsing
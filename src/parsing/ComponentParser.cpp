@@ -10,6 +10,7 @@
 #include "clang/AST/PrettyPrinter.h"
 #include "clang/AST/RawCommentList.h"
 #include "clang/AST/Type.h"
+#include "clang/Basic/FileManager.h"
 #include "clang/Basic/SourceManager.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Support/Path.h"
@@ -35,12 +36,14 @@ ComponentParser::ComponentParser(const IPropertyParser& propertyParser,
                                  const IReferenceParser& referenceParser,
                                  const support::IFileSystem& fileSystem,
                                  core::ErrorCollector& errorCollector,
-                                 const config::ParserConfig& config)
+                                 const config::ParserConfig& config,
+                                 ValidationCache* validationCache)
     : propertyParser_(propertyParser),
       referenceParser_(referenceParser),
       fileSystem_(fileSystem),
       errorCollector_(errorCollector),
-      config_(config) {}
+      config_(config),
+      validationCache_(validationCache) {}
 
 core::Component ComponentParser::parse(const clang::CXXRecordDecl& declaration,
                                        clang::ASTContext& context) const {
@@ -57,9 +60,10 @@ core::Component ComponentParser::parse(const clang::CXXRecordDecl& declaration,
         auto locationInfo = convertSourceLocation(comment->getBeginLoc(), context.getSourceManager());
         
         // Use new comprehensive annotation validator
-        AnnotationValidator annotationValidator;
+        AnnotationValidator annotationValidator(propertyParser_, validationCache_);
+        auto commentText = comment->getRawText(context.getSourceManager());
         auto validationResult = annotationValidator.validateComment(
-            comment->getRawText(context.getSourceManager()).str(), 
+            std::string_view(commentText.data(), commentText.size()),
             locationInfo
         );
         
@@ -92,8 +96,8 @@ core::Component ComponentParser::parse(const clang::CXXRecordDecl& declaration,
         // (by ASTVisitor), we don't need to check for missing @component here.
         // The architecture already ensures @component exists in this comment block.
 
-        parseComponentAttributes(component, *comment, context);
-        parseProperties(component, *comment, declaration, context);
+        parseComponentAttributes(component, validationResult.annotations);
+        parseProperties(component, validationResult.annotations, locationInfo, declaration, context);
     }
 
     parseReferences(component, declaration, context);
@@ -101,62 +105,48 @@ core::Component ComponentParser::parse(const clang::CXXRecordDecl& declaration,
     return component;
 }
 
-void ComponentParser::parseComponentAttributes(core::Component& component,
-                                               const clang::RawComment& comment,
-                                               clang::ASTContext& context) const {
-    auto text = comment.getRawText(context.getSourceManager());
-    auto componentStart = text.find("@component");
-    if (componentStart == llvm::StringRef::npos) {
-        return;
+// First annotation of the given type that has a { ... } body
+static ParsedAnnotation* findAnnotationWithBody(std::vector<ParsedAnnotation>& annotations,
+                                                AnnotationType type) {
+    for (auto& annotation : annotations) {
+        if (annotation.type == type && annotation.isValid && annotation.hasBody) {
+            return &annotation;
+        }
     }
+    return nullptr;
+}
 
-    auto attrStart = text.find('{', componentStart);
-    auto attrEnd = text.find('}', attrStart);
-    if (attrStart == llvm::StringRef::npos || attrEnd == llvm::StringRef::npos || attrStart >= attrEnd) {
+void ComponentParser::parseComponentAttributes(core::Component& component,
+                                               std::vector<ParsedAnnotation>& annotations) const {
+    auto* annotation = findAnnotationWithBody(annotations, AnnotationType::Component);
+    if (!annotation) {
         return;
     }
 
-    auto attributesString = text.substr(attrStart + 1, attrEnd - attrStart - 1);
-    auto attributes = propertyParser_.parse(attributesString.str());
-    if (!attributes.empty()) {
-        component.setAttributes(std::move(attributes));
+    if (!annotation->parsedContent.empty()) {
+        component.setAttributes(std::move(annotation->parsedContent));
     }
 }
 
 void ComponentParser::parseProperties(core::Component& component,
-                                      const clang::RawComment& comment,
+                                      std::vector<ParsedAnnotation>& annotations,
+                                      const support::SourceLocationInfo& commentLocation,
                                       const clang::CXXRecordDecl& declaration,
                                       clang::ASTContext& context) const {
-    auto commentText = comment.getRawText(context.getSourceManager());
-
-    const auto propertiesPos = commentText.find("@properties");
-    if (propertiesPos != llvm::StringRef::npos) {
-        auto jsonStart = commentText.find('{', propertiesPos);
-        auto jsonEnd = commentText.rfind('}');
-        if (jsonStart != llvm::StringRef::npos && jsonEnd != llvm::StringRef::npos && jsonStart < jsonEnd) {
-            auto jsonString = commentText.substr(jsonStart, jsonEnd - jsonStart + 1).str();
-            auto parsed = nlohmann::json::parse(jsonString, nullptr, false);
-            if (!parsed.is_discarded()) {
-                component.setProperties(std::move(parsed));
-            } else {
-                auto locationInfo = convertSourceLocation(comment.getBeginLoc(), context.getSourceManager());
-                errorCollector_.addError("Invalid JSON in @properties for " + component.className(),
-                                         locationInfo,
-                                         core::ErrorSeverity::Error,
-                                         core::ErrorCategory::Property);
-            }
+    if (auto* properties = findAnnotationWithBody(annotations, AnnotationType::Properties)) {
+        if (!properties->parsedContent.is_discarded()) {
+            component.setProperties(std::move(properties->parsedContent));
+        } else {
+            errorCollector_.addError("Invalid JSON in @properties for " + component.className(),
+                                     commentLocation,
+                                     core::ErrorSeverity::Error,
+                                     core::ErrorCategory::Property);
         }
         return;
     }
 
-    const auto propertyPos = commentText.find("@property");
-    if (propertyPos != llvm::StringRef::npos) {
-        auto pathStart = commentText.find('{', propertyPos);
-        auto pathEnd = commentText.find('}', pathStart);
-        if (pathStart != llvm::StringRef::npos && pathEnd != llvm::StringRef::npos && pathStart < pathEnd) {
-            auto filePath = commentText.substr(pathStart + 1, pathEnd - pathStart - 1).str();
-            parseExternalProperties(component, filePath, declaration, context);
-        }
+    if (const auto* property = findAnnotationWithBody(annotations, AnnotationType::Property)) {
+        parseExternalProperties(component, property->content, declaration, context);
     }
 }
 
@@ -176,31 +166,38 @@ void ComponentParser::parseReferences(core::Component& component,
             continue;
         }
 
+        const ReferenceAnnotations annotations(std::string_view(commentText.data(), commentText.size()));
         for (const auto* param : constructor->parameters()) {
             if (!param) {
                 continue;
             }
-            auto [qualified, simplified] = extractInterfaceNames(*param, context);
-            auto reference = referenceParser_.parse(commentText.str(), simplified, qualified);
+            const auto& names = interfaceNames(context).lookup(param->getType());
+            auto reference = referenceParser_.parse(annotations, names.simplified, names.qualified);
             component.addReference(std::move(reference));
         }
     }
 }
 
 void ComponentParser::parseExternalProperties(core::Component& component,
-                                              const std::string& filePath,
+                                              std::string_view filePath,
                                               const clang::CXXRecordDecl& declaration,
                                               clang::ASTContext& context) const {
     const auto& sourceManager = context.getSourceManager();
     auto presumed = sourceManager.getPresumedLoc(declaration.getLocation());
-    std::string resolvedPath = filePath;
-
-    if (presumed.isValid()) {
-        llvm::SmallString<256> basePath(presumed.getFilename());
+    const llvm::StringRef propertyPath(filePath.data(), filePath.size());
+    llvm::SmallString<256> basePath;
+    if (presumed.isValid() && !llvm::sys::path::is_absolute(propertyPath)) {
+        basePath = presumed.getFilename();
         llvm::sys::path::remove_filename(basePath);
-        llvm::sys::path::append(basePath, filePath);
-        resolvedPath = basePath.str().str();
     }
+    llvm::sys::path::append(basePath, propertyPath);
+
+    // Relative compile-database paths are relative to the compile command's
+    // directory, which is the file manager's working directory but not the
+    // process's; the file system below opens paths against the latter.
+    sourceManager.getFileManager().makeAbsolutePath(basePath);
+    llvm::sys::path::remove_dots(basePath, /*remove_dot_dot=*/true);
+    const std::string resolvedPath = basePath.str().str();
 
     auto jsonContent = fileSystem_.readJsonFile(resolvedPath);
     if (!jsonContent) {
@@ -215,52 +212,11 @@ void ComponentParser::parseExternalProperties(core::Component& component,
     component.setProperties(std::move(*jsonContent));
 }
 
-std::pair<std::string, std::string> ComponentParser::extractInterfaceNames(const clang::ParmVarDecl& param,
-                                                                           clang::ASTContext& context) const {
-    clang::QualType spelled = param.getType().getNonReferenceType();
-    clang::QualType target = spelled;
-
-    if (const auto* specialization = target->getAs<clang::TemplateSpecializationType>()) {
-        if (const auto* templateDecl = specialization->getTemplateName().getAsTemplateDecl()) {
-            const std::string qualifiedName = templateDecl->getQualifiedNameAsString();
-            if (qualifiedName == "std::shared_ptr" || qualifiedName == "std::unique_ptr") {
-                const auto& args = specialization->template_arguments();
-                if (!args.empty() && args[0].getKind() == clang::TemplateArgument::Type) {
-                    target = args[0].getAsType().getNonReferenceType();
-                }
-            }
-        }
+InterfaceNameCache& ComponentParser::interfaceNames(const clang::ASTContext& context) const {
+    if (!interfaceNames_ || &interfaceNames_->context() != &context) {
+        interfaceNames_.emplace(context);
     }
-
-    clang::QualType canonical = context.getCanonicalType(target).getUnqualifiedType();
-
-    clang::PrintingPolicy fqPolicy(context.getLangOpts());
-    fqPolicy.adjustForCPlusPlus();
-    fqPolicy.FullyQualifiedName = true;
-    std::string fullyQualifiedName = canonical.getAsString(fqPolicy);
-
-    clang::PrintingPolicy displayPolicy(context.getLangOpts());
-    displayPolicy.adjustForCPlusPlus();
-    displayPolicy.FullyQualifiedName = false;
-    std::string displayName = target.getAsString(displayPolicy);
-
-    std::string simplified = displayName;
-    if (auto lt = simplified.rfind('<'); lt != std::string::npos) {
-        simplified = simplified.substr(lt + 1);
-        if (!simplified.empty() && simplified.back() == '>') {
-            simplified.pop_back();
-        }
-    }
-
-    llvm::StringRef simplifiedRef(simplified);
-    simplifiedRef = simplifiedRef.trim();
-    if (auto pos = simplifiedRef.rfind("::"); pos != llvm::StringRef::npos) {
-        simplified = simplifiedRef.substr(pos + 2).str();
-    } else {
-        simplified = simplifiedRef.str();
-    }
-
-    return {fullyQualifiedName, simplified};
+    return *interfaceNames_;
 }
 
 } // namespace dsannotation::parsing
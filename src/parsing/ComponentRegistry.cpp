@@ -0,0 +1,58 @@
+#include "dsannotation/parsing/ComponentRegistry.h"
+
+namespace dsannotation::parsing {
+
+ComponentRegistry::Resolution ComponentRegistry::resolve(const std::string& key,
+                                                         std::uint64_t fingerprint,
+                                                         const std::function<Parsed()>& parse) {
+    std::promise<Parsed> promise;
+    std::shared_future<Parsed> existing;
+    bool conflict = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = entries_.find(key);
+        if (it == entries_.end()) {
+            entries_.emplace(key, Entry{fingerprint, promise.get_future().share()});
+        } else if (it->second.fingerprint != fingerprint) {
+            conflict = true;
+        } else {
+            existing = it->second.parsed;
+        }
+    }
+
+    Resolution resolution;
+    if (conflict) {
+        ++conflictCount_;
+        resolution.component = parse().component;
+        resolution.conflict = true;
+        return resolution;
+    }
+
+    if (existing.valid()) {
+        // Another translation unit may still be parsing; wait for its result.
+        const auto& parsed = existing.get();
+        resolution.component = parsed.component;
+        resolution.errors = parsed.errors;
+        resolution.dependencies = parsed.dependencies;
+        ++reuseCount_;
+        return resolution;
+    }
+
+    try {
+        auto parsed = parse();
+        resolution.component = parsed.component;
+        promise.set_value(std::move(parsed));
+        resolution.firstSighting = true;
+    } catch (...) {
+        promise.set_exception(std::current_exception());
+        throw;
+    }
+    return resolution;
+}
+
+std::size_t ComponentRegistry::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.size();
+}
+
+} // namespace dsannotation::parsing
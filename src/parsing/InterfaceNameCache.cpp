@@ -0,0 +1,69 @@
+#include "dsannotation/parsing/InterfaceNameCache.h"
+
+#include "clang/AST/DeclTemplate.h"
+#include "llvm/ADT/StringRef.h"
+
+namespace dsannotation::parsing {
+
+static clang::PrintingPolicy makePolicy(const clang::ASTContext& context, bool fullyQualified) {
+    clang::PrintingPolicy policy(context.getLangOpts());
+    policy.adjustForCPlusPlus();
+    policy.FullyQualifiedName = fullyQualified;
+    return policy;
+}
+
+InterfaceNameCache::InterfaceNameCache(const clang::ASTContext& context)
+    : context_(context),
+      qualifiedPolicy_(makePolicy(context, true)),
+      displayPolicy_(makePolicy(context, false)) {}
+
+const InterfaceNames& InterfaceNameCache::lookup(clang::QualType parameterType) {
+    auto [it, inserted] = entries_.try_emplace(parameterType.getAsOpaquePtr());
+    if (inserted) {
+        it->second = compute(parameterType);
+    } else {
+        ++hits_;
+    }
+    return it->second;
+}
+
+InterfaceNames InterfaceNameCache::compute(clang::QualType parameterType) const {
+    clang::QualType spelled = parameterType.getNonReferenceType();
+    clang::QualType target = spelled;
+
+    if (const auto* specialization = target->getAs<clang::TemplateSpecializationType>()) {
+        if (const auto* templateDecl = specialization->getTemplateName().getAsTemplateDecl()) {
+            const std::string qualifiedName = templateDecl->getQualifiedNameAsString();
+            if (qualifiedName == "std::shared_ptr" || qualifiedName == "std::unique_ptr") {
+                const auto& args = specialization->template_arguments();
+                if (!args.empty() && args[0].getKind() == clang::TemplateArgument::Type) {
+                    target = args[0].getAsType().getNonReferenceType();
+                }
+            }
+        }
+    }
+
+    clang::QualType canonical = context_.getCanonicalType(target).getUnqualifiedType();
+    std::string fullyQualifiedName = canonical.getAsString(qualifiedPolicy_);
+    std::string displayName = target.getAsString(displayPolicy_);
+
+    std::string simplified = displayName;
+    if (auto lt = simplified.rfind('<'); lt != std::string::npos) {
+        simplified = simplified.substr(lt + 1);
+        if (!simplified.empty() && simplified.back() == '>') {
+            simplified.pop_back();
+        }
+    }
+
+    llvm::StringRef simplifiedRef(simplified);
+    simplifiedRef = simplifiedRef.trim();
+    if (auto pos = simplifiedRef.rfind("::"); pos != llvm::StringRef::npos) {
+        simplified = simplifiedRef.substr(pos + 2).str();
+    } else {
+        simplified = simplifiedRef.str();
+    }
+
+    return {std::move(fullyQualifiedName), std::move(simplified)};
+}
+
+} // namespace dsannotation::parsing
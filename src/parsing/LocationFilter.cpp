@@ -0,0 +1,122 @@
+#include "dsannotation/parsing/LocationFilter.h"
+
+#include <filesystem>
+#include <system_error>
+
+#include "clang/Basic/FileManager.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/Support/Path.h"
+
+namespace dsannotation::parsing {
+
+namespace {
+std::string normalizePrefix(const std::string& prefix) {
+    std::error_code error;
+    auto path = std::filesystem::weakly_canonical(std::filesystem::path(prefix), error);
+    if (error) {
+        path = std::filesystem::absolute(std::filesystem::path(prefix), error).lexically_normal();
+    }
+    auto normalized = path.generic_string();
+    while (normalized.size() > 1 && normalized.back() == '/') {
+        normalized.pop_back();
+    }
+    return normalized;
+}
+
+std::vector<std::string> normalizePrefixes(const std::vector<std::string>& prefixes) {
+    std::vector<std::string> normalized;
+    normalized.reserve(prefixes.size());
+    for (const auto& prefix : prefixes) {
+        if (!prefix.empty()) {
+            normalized.push_back(normalizePrefix(prefix));
+        }
+    }
+    return normalized;
+}
+
+// Prefix match on whole path components.
+bool hasPathPrefix(llvm::StringRef path, llvm::StringRef prefix) {
+#ifdef _WIN32
+    const bool matches = path.startswith_insensitive(prefix);
+#else
+    const bool matches = path.startswith(prefix);
+#endif
+    return matches && (path.size() == prefix.size() || prefix.endswith("/") || path[prefix.size()] == '/');
+}
+
+bool matchesAny(llvm::StringRef path, const std::vector<std::string>& prefixes) {
+    for (const auto& prefix : prefixes) {
+        if (hasPathPrefix(path, prefix)) {
+            return true;
+        }
+    }
+    return false;
+}
+} // namespace
+
+LocationFilter::LocationFilter(const clang::SourceManager& sourceManager, const config::ParserConfig& config)
+    : sourceManager_(sourceManager),
+      skipSystemHeaders_(config.skipSystemHeaders),
+      includePrefixes_(normalizePrefixes(config.includePathPrefixes)),
+      excludePrefixes_(normalizePrefixes(config.excludePathPrefixes)) {}
+
+bool LocationFilter::isActive() const noexcept {
+    return skipSystemHeaders_ || !includePrefixes_.empty() || !excludePrefixes_.empty();
+}
+
+bool LocationFilter::accepts(clang::FileID file) {
+    if (file.isInvalid()) {
+        return true;
+    }
+    auto [it, inserted] = decisions_.try_emplace(file, true);
+    if (inserted) {
+        it->second = classify(file);
+    }
+    return it->second;
+}
+
+bool LocationFilter::accepts(const clang::Decl& declaration) {
+    auto begin = sourceManager_.getFileID(sourceManager_.getExpansionLoc(declaration.getBeginLoc()));
+    auto end = sourceManager_.getFileID(sourceManager_.getExpansionLoc(declaration.getEndLoc()));
+    if (begin != end) {
+        return true;
+    }
+    return accepts(begin);
+}
+
+bool LocationFilter::classify(clang::FileID file) const {
+    if (skipSystemHeaders_ && sourceManager_.isInSystemHeader(sourceManager_.getLocForStartOfFile(file))) {
+        return false;
+    }
+    if (includePrefixes_.empty() && excludePrefixes_.empty()) {
+        return true;
+    }
+
+    const auto path = absolutePath(file);
+    if (path.empty()) {
+        // Built-in buffers and other virtual files have no path to match.
+        return includePrefixes_.empty();
+    }
+    if (matchesAny(path, excludePrefixes_)) {
+        return false;
+    }
+    return includePrefixes_.empty() || matchesAny(path, includePrefixes_);
+}
+
+std::string LocationFilter::absolutePath(clang::FileID file) const {
+    const auto* entry = sourceManager_.getFileEntryForID(file);
+    if (!entry) {
+        return {};
+    }
+
+    llvm::SmallString<256> path(entry->tryGetRealPathName());
+    if (path.empty()) {
+        path = entry->getName();
+        sourceManager_.getFileManager().makeAbsolutePath(path);
+        llvm::sys::path::remove_dots(path, /*remove_dot_dot=*/true);
+    }
+    return llvm::sys::path::convert_to_slash(path);
+}
+
+} // namespace dsannotation::parsing
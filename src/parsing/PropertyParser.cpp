@@ -1,77 +1,116 @@
 #include "dsannotation/parsing/PropertyParser.h"
 
-#include <algorithm>
 #include <cctype>
-#include <regex>
-#include <sstream>
+#include <charconv>
 #include <string>
 #include <string_view>
-#include <vector>
+#include <system_error>
 
 namespace dsannotation::parsing {
 
-nlohmann::json PropertyParser::parse(std::string_view propertiesText) const {
-    nlohmann::json propertiesJson = nlohmann::json::object();
-    if (propertiesText.empty()) {
-        return propertiesJson;
+namespace {
+constexpr std::string_view whitespace = " \t\n\v\f\r";
+
+std::string_view trim(std::string_view text) {
+    const auto first = text.find_first_not_of(whitespace);
+    if (first == std::string_view::npos) {
+        return {};
     }
+    const auto last = text.find_last_not_of(whitespace);
+    return text.substr(first, last - first + 1);
+}
 
-    std::vector<std::string> properties;
-    std::string current;
-    bool inArray = false;
+bool isDigit(char c) {
+    return c >= '0' && c <= '9';
+}
 
-    for (char c : propertiesText) {
-        if (c == '[') {
-            inArray = true;
-        } else if (c == ']') {
-            inArray = false;
-        }
+// Cardinality patterns like "0..1", "1..1", "0..n", "1..n": digits, "..",
+// optional digits, optional 'n'.
+bool isCardinality(std::string_view text) {
+    std::size_t i = 0;
+    while (i < text.size() && isDigit(text[i])) {
+        ++i;
+    }
+    if (i == 0 || text.substr(i, 2) != "..") {
+        return false;
+    }
+    i += 2;
+    while (i < text.size() && isDigit(text[i])) {
+        ++i;
+    }
+    if (i < text.size() && text[i] == 'n') {
+        ++i;
+    }
+    return i == text.size();
+}
 
-        if (c == ',' && !inArray) {
-            if (!current.empty()) {
-                properties.push_back(current);
-                current.clear();
+// Numbers are parsed from the longest valid prefix, like stoi/stod; values
+// that do not start with a number or do not fit stay strings.
+template <typename T>
+bool parseNumber(std::string_view text, nlohmann::json& number) {
+    T value{};
+    const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+    if (error != std::errc{}) {
+        return false;
+    }
+    number = value;
+    return true;
+}
+} // namespace
+
+nlohmann::json PropertyParser::parse(std::string_view propertiesText) const {
+    nlohmann::json propertiesJson = nlohmann::json::object();
+
+    // Properties are separated by commas outside of [...] lists.
+    bool inArray = false;
+    std::size_t propertyStart = 0;
+    for (std::size_t i = 0; i <= propertiesText.size(); ++i) {
+        if (i < propertiesText.size()) {
+            const char c = propertiesText[i];
+            if (c == '[') {
+                inArray = true;
+            } else if (c == ']') {
+                inArray = false;
+            }
+            if (c != ',' || inArray) {
+                continue;
             }
-        } else {
-            current.push_back(c);
         }
-    }
 
-    if (!current.empty()) {
-        properties.push_back(current);
-    }
+        const auto property = trim(propertiesText.substr(propertyStart, i - propertyStart));
+        propertyStart = i + 1;
 
-    std::regex trimRegex("^\\s+|\\s+$");
-    for (auto& property : properties) {
-        property = std::regex_replace(property, trimRegex, "");
-        auto delimiterPos = property.find('=');
-        if (delimiterPos == std::string::npos) {
+        const auto delimiterPos = property.find('=');
+        if (delimiterPos == std::string_view::npos) {
             continue;
         }
 
-        std::string key = std::regex_replace(property.substr(0, delimiterPos), trimRegex, "");
-        std::string value = std::regex_replace(property.substr(delimiterPos + 1), trimRegex, "");
-
-        auto parsedValue = parseValue(value);
-        setNestedProperty(propertiesJson, key, parsedValue);
+        const auto key = trim(property.substr(0, delimiterPos));
+        const auto value = trim(property.substr(delimiterPos + 1));
+        setNestedProperty(propertiesJson, key, parseValue(value));
     }
 
     return propertiesJson;
 }
 
 nlohmann::json PropertyParser::parseValue(std::string_view value) const {
-    std::string trimmed = std::regex_replace(std::string(value), std::regex("^\\s+|\\s+$"), "");
+    const auto trimmed = trim(value);
     if (trimmed.empty()) {
         return nlohmann::json();
     }
 
     if (trimmed.front() == '[' && trimmed.back() == ']') {
-        std::string content = trimmed.substr(1, trimmed.size() - 2);
-        std::vector<std::string> arrayValues;
-        std::istringstream stream(content);
-        std::string item;
-        while (std::getline(stream, item, ',')) {
-            arrayValues.push_back(std::regex_replace(item, std::regex("^\\s+|\\s+$"), ""));
+        // Items are split on every comma; a trailing empty item is dropped.
+        const auto content = trimmed.substr(1, trimmed.size() - 2);
+        nlohmann::json arrayValues = nlohmann::json::array();
+        std::size_t itemStart = 0;
+        while (itemStart < content.size()) {
+            auto comma = content.find(',', itemStart);
+            if (comma == std::string_view::npos) {
+                comma = content.size();
+            }
+            arrayValues.push_back(std::string(trim(content.substr(itemStart, comma - itemStart))));
+            itemStart = comma + 1;
         }
         return arrayValues;
     }
@@ -86,31 +125,26 @@ nlohmann::json PropertyParser::parseValue(std::string_view value) const {
 
     // Check for cardinality patterns like "0..1", "1..1", "0..n", "1..n" etc.
     // These should remain as strings, not be parsed as numbers
-    std::regex cardinalityPattern(R"(^\d+\.\.\d*[n]?$)");
-    if (std::regex_match(trimmed, cardinalityPattern)) {
-        return trimmed;
+    if (isCardinality(trimmed)) {
+        return std::string(trimmed);
     }
 
-    if (!trimmed.empty() && std::all_of(trimmed.begin(), trimmed.end(), [](char ch) {
-            return std::isdigit(static_cast<unsigned char>(ch)) || ch == '.' || ch == '-';
-        })) {
-        try {
-            if (trimmed.find('.') != std::string::npos) {
-                return std::stod(trimmed);
-            }
-            return std::stoi(trimmed);
-        } catch (...) {
-            // fallthrough to string
+    if (trimmed.find_first_not_of("0123456789.-") == std::string_view::npos) {
+        nlohmann::json number;
+        const bool parsed = trimmed.find('.') != std::string_view::npos ? parseNumber<double>(trimmed, number)
+                                                                        : parseNumber<int>(trimmed, number);
+        if (parsed) {
+            return number;
         }
     }
 
     if (trimmed.size() >= 2 &&
         ((trimmed.front() == '"' && trimmed.back() == '"') ||
          (trimmed.front() == '\'' && trimmed.back() == '\''))) {
-        return trimmed.substr(1, trimmed.size() - 2);
+        return std::string(trimmed.substr(1, trimmed.size() - 2));
     }
 
-    return trimmed;
+    return std::string(trimmed);
 }
 
 void PropertyParser::setNestedProperty(nlohmann::json& json,
@@ -0,0 +1,44 @@
+#include "dsannotation/parsing/ReferenceAnnotations.h"
+
+namespace dsannotation::parsing {
+
+namespace {
+constexpr std::string_view keyword = "@reference";
+constexpr std::string_view whitespace = " \t\n\v\f\r";
+} // namespace
+
+// Accepts exactly what '@reference\s+<target>\s*\{([^}]*)\}' matches: the
+// target is everything between the whitespace after the keyword and the
+// whitespace before the first '{', and the block ends at the first '}'.
+ReferenceAnnotations::ReferenceAnnotations(std::string_view commentText) {
+    for (auto position = commentText.find(keyword); position != std::string_view::npos;
+         position = commentText.find(keyword, position + 1)) {
+        const auto afterKeyword = position + keyword.size();
+        const auto targetBegin = commentText.find_first_not_of(whitespace, afterKeyword);
+        if (targetBegin == afterKeyword || targetBegin == std::string_view::npos) {
+            continue;
+        }
+
+        const auto blockBegin = commentText.find('{', targetBegin);
+        if (blockBegin == std::string_view::npos) {
+            continue;
+        }
+        const auto blockEnd = commentText.find('}', blockBegin + 1);
+        if (blockEnd == std::string_view::npos) {
+            continue;
+        }
+
+        auto target = commentText.substr(targetBegin, blockBegin - targetBegin);
+        const auto targetEnd = target.find_last_not_of(whitespace);
+        target = targetEnd == std::string_view::npos ? std::string_view{} : target.substr(0, targetEnd + 1);
+
+        blocks_.try_emplace(target, commentText.substr(blockBegin + 1, blockEnd - blockBegin - 1));
+    }
+}
+
+const std::string_view* ReferenceAnnotations::find(std::string_view target) const {
+    auto it = blocks_.find(target);
+    return it == blocks_.end() ? nullptr : &it->second;
+}
+
+} // namespace dsannotation::parsing
@@ -0,0 +1,45 @@
+#include "dsannotation/parsing/ValidationCache.h"
+
+#include <mutex>
+#include <utility>
+
+#include "dsannotation/support/ContentHash.h"
+
+namespace dsannotation::parsing {
+
+std::shared_ptr<const ValidationCache::Entry> ValidationCache::find(std::string_view text) const {
+    const auto digest = support::hashContent(text);
+    std::shared_lock lock(mutex_);
+    auto entry = findLocked(digest, text);
+    ++(entry ? hits_ : misses_);
+    return entry;
+}
+
+std::shared_ptr<const ValidationCache::Entry> ValidationCache::insert(Entry entry) {
+    const auto digest = support::hashContent(entry.text);
+    auto stored = std::make_shared<const Entry>(std::move(entry));
+    std::unique_lock lock(mutex_);
+    if (auto existing = findLocked(digest, stored->text)) {
+        return existing;
+    }
+    entries_.emplace(digest, stored);
+    return stored;
+}
+
+std::size_t ValidationCache::size() const {
+    std::shared_lock lock(mutex_);
+    return entries_.size();
+}
+
+std::shared_ptr<const ValidationCache::Entry> ValidationCache::findLocked(std::uint64_t digest,
+                                                                          std::string_view text) const {
+    auto [first, last] = entries_.equal_range(digest);
+    for (auto it = first; it != last; ++it) {
+        if (it->second->text == text) {
+            return it->second;
+        }
+    }
+    return nullptr;
+}
+
+} // namespace dsannotation::parsing
@@ -0,0 +1,69 @@
+#include "dsannotation/serialization/CanonicalOrder.h"
+
+#include <algorithm>
+
+namespace dsannotation::serialization {
+
+namespace {
+const nlohmann::json kMissing;
+
+// Value of `key` in an object entry; null for anything else
+const nlohmann::json& memberOrNull(const nlohmann::json& entry, const char* key) {
+    if (entry.is_object()) {
+        auto it = entry.find(key);
+        if (it != entry.end()) {
+            return *it;
+        }
+    }
+    return kMissing;
+}
+
+void sortByMember(nlohmann::json& array, const char* key) {
+    std::stable_sort(array.begin(), array.end(), [key](const nlohmann::json& lhs, const nlohmann::json& rhs) {
+        return memberOrNull(lhs, key) < memberOrNull(rhs, key);
+    });
+}
+} // namespace
+
+nlohmann::json canonicalKey(const core::Component& component) {
+    const auto& attributes = component.attributes();
+    if (attributes.is_object() && attributes.contains("implementation-class")) {
+        return attributes["implementation-class"];
+    }
+    return component.className();
+}
+
+nlohmann::json canonicalKey(const core::Reference& reference) {
+    const auto& properties = reference.properties();
+    if (properties.is_object() && properties.contains("name")) {
+        return properties["name"];
+    }
+    return reference.name();
+}
+
+void sortManifest(nlohmann::json& manifest) {
+    if (!manifest.is_object()) {
+        return;
+    }
+    auto scr = manifest.find("scr");
+    if (scr == manifest.end() || !scr->is_object()) {
+        return;
+    }
+    auto components = scr->find("components");
+    if (components == scr->end() || !components->is_array()) {
+        return;
+    }
+
+    sortByMember(*components, "implementation-class");
+    for (auto& component : *components) {
+        if (!component.is_object()) {
+            continue;
+        }
+        auto references = component.find("references");
+        if (references != component.end() && references->is_array()) {
+            sortByMember(*references, "name");
+        }
+    }
+}
+
+} // namespace dsannotation::serialization
@@ -0,0 +1,92 @@
+#include "dsannotation/serialization/ComponentCodec.h"
+
+namespace dsannotation::serialization {
+
+nlohmann::json encodeComponent(const core::Component& component) {
+    nlohmann::json json;
+    json["class"] = component.className();
+    json["interfaces"] = component.interfaces();
+    json["attributes"] = component.attributes();
+    json["properties"] = component.properties();
+
+    nlohmann::json references = nlohmann::json::array();
+    for (const auto& reference : component.references()) {
+        references.push_back({{"name", reference.name()},
+                              {"interface", reference.interface()},
+                              {"properties", reference.properties()}});
+    }
+    json["references"] = std::move(references);
+    return json;
+}
+
+std::optional<core::Component> decodeComponent(const nlohmann::json& json) {
+    if (!json.is_object() || !json.contains("class") || !json["class"].is_string()) {
+        return std::nullopt;
+    }
+
+    core::Component component(json["class"].get<std::string>());
+
+    if (auto it = json.find("interfaces"); it != json.end() && it->is_array()) {
+        for (const auto& interfaceName : *it) {
+            if (!interfaceName.is_string()) {
+                return std::nullopt;
+            }
+            component.addInterface(interfaceName.get<std::string>());
+        }
+    }
+    if (auto it = json.find("attributes"); it != json.end()) {
+        component.setAttributes(*it);
+    }
+    if (auto it = json.find("properties"); it != json.end()) {
+        component.setProperties(*it);
+    }
+    if (auto it = json.find("references"); it != json.end() && it->is_array()) {
+        for (const auto& referenceJson : *it) {
+            if (!referenceJson.is_object()) {
+                return std::nullopt;
+            }
+            const auto name = referenceJson.find("name");
+            const auto interfaceName = referenceJson.find("interface");
+            if ((name != referenceJson.end() && !name->is_string()) ||
+                (interfaceName != referenceJson.end() && !interfaceName->is_string())) {
+                return std::nullopt;
+            }
+            core::Reference reference(name != referenceJson.end() ? name->get<std::string>() : std::string{},
+                                      interfaceName != referenceJson.end() ? interfaceName->get<std::string>()
+                                                                           : std::string{});
+            if (auto props = referenceJson.find("properties"); props != referenceJson.end()) {
+                reference.setProperties(*props);
+            }
+            component.addReference(std::move(reference));
+        }
+    }
+
+    return component;
+}
+
+nlohmann::json encodeComponents(const core::ComponentList& components) {
+    nlohmann::json json = nlohmann::json::array();
+    for (const auto& component : components) {
+        json.push_back(encodeComponent(component));
+    }
+    return json;
+}
+
+std::optional<core::ComponentList> decodeComponents(const nlohmann::json& json) {
+    if (!json.is_array()) {
+        return std::nullopt;
+    }
+
+    core::ComponentList components;
+    components.reserve(json.size());
+    for (const auto& componentJson : json) {
+        auto component = decodeComponent(componentJson);
+        if (!component) {
+            return std::nullopt;
+        }
+        components.push_back(std::move(*component));
+    }
+    return components;
+}
+
+} // namespace dsannotation::serialization
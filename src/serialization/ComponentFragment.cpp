@@ -0,0 +1,90 @@
+#include "dsannotation/serialization/ComponentFragment.h"
+
+#include <cstddef>
+
+#include "dsannotation/serialization/ComponentCodec.h"
+#include "dsannotation/support/MappedFile.h"
+
+namespace dsannotation::serialization {
+
+namespace {
+constexpr std::string_view kMagic("DSFRAG\r\n", 8);
+constexpr std::size_t kHeaderSize = 56;
+
+void appendLittleEndian(std::string& out, std::uint64_t value, int bytes) {
+    for (int i = 0; i < bytes; ++i) {
+        out.push_back(static_cast<char>((value >> (i * 8)) & 0xff));
+    }
+}
+
+std::uint64_t readLittleEndian(std::string_view bytes, std::size_t offset, int size) {
+    std::uint64_t value = 0;
+    for (int i = 0; i < size; ++i) {
+        value |= static_cast<std::uint64_t>(static_cast<unsigned char>(bytes[offset + i])) << (i * 8);
+    }
+    return value;
+}
+} // namespace
+
+std::string encodeFragment(const ComponentFragment& fragment) {
+    const nlohmann::json payload{{"source", fragment.sourcePath},
+                                 {"components", encodeComponents(fragment.components)}};
+    const auto cbor = nlohmann::json::to_cbor(payload);
+
+    std::string bytes;
+    bytes.reserve(kHeaderSize + cbor.size());
+    bytes.append(kMagic);
+    appendLittleEndian(bytes, kFragmentFormatVersion, 4);
+    appendLittleEndian(bytes, 0, 4);
+    appendLittleEndian(bytes, fragment.sourceFingerprint, 8);
+    appendLittleEndian(bytes, fragment.ordinal, 8);
+    appendLittleEndian(bytes, fragment.runIdentity, 8);
+    appendLittleEndian(bytes, fragment.shardIndex, 4);
+    appendLittleEndian(bytes, fragment.shardCount, 4);
+    appendLittleEndian(bytes, cbor.size(), 8);
+    bytes.append(reinterpret_cast<const char*>(cbor.data()), cbor.size());
+    return bytes;
+}
+
+std::optional<ComponentFragment> decodeFragment(std::string_view bytes) {
+    if (bytes.size() < kHeaderSize || bytes.substr(0, kMagic.size()) != kMagic ||
+        readLittleEndian(bytes, 8, 4) != kFragmentFormatVersion ||
+        readLittleEndian(bytes, 48, 8) != bytes.size() - kHeaderSize) {
+        return std::nullopt;
+    }
+
+    const auto payload = bytes.substr(kHeaderSize);
+    const auto json = nlohmann::json::from_cbor(payload.begin(), payload.end(), true, false);
+    if (json.is_discarded() || !json.is_object()) {
+        return std::nullopt;
+    }
+    const auto source = json.find("source");
+    const auto componentsJson = json.find("components");
+    if (source == json.end() || !source->is_string() || componentsJson == json.end()) {
+        return std::nullopt;
+    }
+    auto components = decodeComponents(*componentsJson);
+    if (!components) {
+        return std::nullopt;
+    }
+
+    ComponentFragment fragment;
+    fragment.sourcePath = source->get<std::string>();
+    fragment.sourceFingerprint = readLittleEndian(bytes, 16, 8);
+    fragment.ordinal = readLittleEndian(bytes, 24, 8);
+    fragment.runIdentity = readLittleEndian(bytes, 32, 8);
+    fragment.shardIndex = static_cast<std::uint32_t>(readLittleEndian(bytes, 40, 4));
+    fragment.shardCount = static_cast<std::uint32_t>(readLittleEndian(bytes, 44, 4));
+    fragment.components = std::move(*components);
+    return fragment;
+}
+
+std::optional<ComponentFragment> readFragment(const std::string& path) {
+    auto file = support::MappedFile::open(path);
+    if (!file) {
+        return std::nullopt;
+    }
+    return decodeFragment(file->contents());
+}
+
+} // namespace dsannotation::serialization
@@ -2,16 +2,20 @@
 
 #include <exception>
 
+#include "dsannotation/serialization/CanonicalOrder.h"
+
 namespace dsannotation::serialization {
 
 JsonManifestWriter::JsonManifestWriter(const IManifestBuilder& builder,
                                        const IManifestMerger& merger,
                                        const support::IFileSystem& fileSystem,
-                                       int indentation)
+                                       int indentation,
+                                       bool canonicalOrder)
     : builder_(builder),
       merger_(merger),
       fileSystem_(fileSystem),
-      indentation_(indentation) {}
+      indentation_(indentation),
+      canonicalOrder_(canonicalOrder) {}
 
 core::Result<bool> JsonManifestWriter::writeManifest(const core::ComponentList& components,
                                                      const std::string& existingManifestPath,
@@ -19,14 +23,17 @@ core::Result<bool> JsonManifestWriter::writeManifest(const core::ComponentList&
     try {
         auto generated = builder_.buildManifest(components);
         auto merged = merger_.merge(existingManifestPath, generated);
+        if (canonicalOrder_) {
+            sortManifest(merged);
+        }
 
-        const bool success = fileSystem_.writeTextFile(outputPath,
-                                                       merged.dump(indentation_));
-        if (!success) {
+        const auto status = fileSystem_.writeTextFile(outputPath,
+                                                      merged.dump(indentation_));
+        if (status == support::WriteStatus::Failed) {
             return core::Result<bool>::error("Failed to write manifest to " + outputPath);
         }
 
-        return core::Result<bool>::success(true);
+        return core::Result<bool>::success(status == support::WriteStatus::Written);
     } catch (const std::exception& ex) {
         return core::Result<bool>::error(ex.what());
     }
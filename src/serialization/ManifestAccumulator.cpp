@@ -0,0 +1,68 @@
+#include "dsannotation/serialization/ManifestAccumulator.h"
+
+#include <utility>
+
+namespace dsannotation::serialization {
+
+void ManifestAccumulator::add(nlohmann::json manifest) {
+    if (manifest_.empty()) {
+        manifest_ = std::move(manifest);
+        positions_.clear();
+        indexed_ = 0;
+        return;
+    }
+
+    if (!manifest_.contains("scr")) {
+        manifest_["scr"] = nlohmann::json::object();
+    }
+
+    if (!manifest.contains("scr")) {
+        return;
+    }
+
+    mergeComponents(manifest_["scr"], manifest["scr"]);
+}
+
+nlohmann::json ManifestAccumulator::release() {
+    positions_.clear();
+    indexed_ = 0;
+    return std::exchange(manifest_, nlohmann::json());
+}
+
+void ManifestAccumulator::mergeComponents(nlohmann::json& target, const nlohmann::json& source) {
+    if (!source.contains("components")) {
+        return;
+    }
+
+    if (!target.contains("components")) {
+        target["components"] = nlohmann::json::array();
+    }
+
+    auto& targetComponents = target["components"];
+    const auto& sourceComponents = source["components"];
+    if (sourceComponents.empty()) {
+        return;
+    }
+
+    // Entries of the base document are indexed on first use. With duplicate
+    // entries the first one is updated and the others are kept untouched;
+    // appended components are indexed too, so a class that is merged twice
+    // updates its own first entry.
+    positions_.reserve(targetComponents.size() + sourceComponents.size());
+    for (; indexed_ < targetComponents.size(); ++indexed_) {
+        positions_.emplace(targetComponents[indexed_].value("implementation-class", ""), indexed_);
+    }
+
+    for (const auto& sourceComponent : sourceComponents) {
+        auto [it, inserted] = positions_.emplace(sourceComponent.value("implementation-class", ""),
+                                                 targetComponents.size());
+        if (inserted) {
+            targetComponents.push_back(sourceComponent);
+        } else {
+            targetComponents[it->second].update(sourceComponent);
+        }
+    }
+    indexed_ = targetComponents.size();
+}
+
+} // namespace dsannotation::serialization
@@ -1,5 +1,7 @@
 #include "dsannotation/serialization/ManifestMerger.h"
 
+#include "dsannotation/serialization/ManifestAccumulator.h"
+
 namespace dsannotation::serialization {
 
 ManifestMerger::ManifestMerger(const support::IFileSystem& fileSystem)
@@ -7,22 +9,10 @@ ManifestMerger::ManifestMerger(const support::IFileSystem& fileSystem)
 
 nlohmann::json ManifestMerger::merge(const std::string& existingPath,
                                      const nlohmann::json& generated) const {
-    auto existing = readExistingManifest(existingPath);
-    if (existing.empty()) {
-        return generated;
-    }
-
-    nlohmann::json result = existing;
-    if (!result.contains("scr")) {
-        result["scr"] = nlohmann::json::object();
-    }
-
-    if (!generated.contains("scr")) {
-        return result;
-    }
-
-    mergeComponents(result["scr"], generated["scr"]);
-    return result;
+    ManifestAccumulator accumulator;
+    accumulator.add(readExistingManifest(existingPath));
+    accumulator.add(generated);
+    return accumulator.release();
 }
 
 nlohmann::json ManifestMerger::readExistingManifest(const std::string& path) const {
@@ -37,29 +27,4 @@ nlohmann::json ManifestMerger::readExistingManifest(const std::string& path) con
     return *json;
 }
 
-void ManifestMerger::mergeComponents(nlohmann::json& target, const nlohmann::json& source) const {
-    if (!source.contains("components")) {
-        return;
-    }
-
-    if (!target.contains("components")) {
-        target["components"] = nlohmann::json::array();
-    }
-
-    for (const auto& sourceComponent : source["components"]) {
-        bool updated = false;
-        for (auto& targetComponent : target["components"]) {
-            if (targetComponent.value("implementation-class", "") ==
-                sourceComponent.value("implementation-class", "")) {
-                targetComponent.update(sourceComponent);
-                updated = true;
-                break;
-            }
-        }
-        if (!updated) {
-            target["components"].push_back(sourceComponent);
-        }
-    }
-}
-
 } // namespace dsannotation::serialization
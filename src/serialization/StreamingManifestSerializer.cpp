@@ -0,0 +1,211 @@
+#include "dsannotation/serialization/StreamingManifestSerializer.h"
+
+#include <algorithm>
+#include <map>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "dsannotation/serialization/CanonicalOrder.h"
+
+namespace dsannotation::serialization {
+
+// Emits the same layout as nlohmann::json::dump: object members in key
+// order, ": " and newline-separated members when pretty printing.
+class StreamingManifestSerializer::Writer {
+public:
+    Writer(std::ostream& output, int indentation)
+        : output_(output), indentation_(indentation) {}
+
+    void beginObject() { begin('{'); }
+    void endObject() { end('}'); }
+    void beginArray() { begin('['); }
+    void endArray() { end(']'); }
+
+    // Separator before every member/element but the first
+    void next(bool first) {
+        if (!first) {
+            output_ << ',';
+        }
+        newline();
+    }
+
+    void key(std::string_view name) {
+        output_ << nlohmann::json(name).dump() << (pretty() ? ": " : ":");
+    }
+
+    // Nested values are dumped at indentation 0 and shifted to the current
+    // depth. String values never contain raw newlines, so every newline in
+    // the dump is a line break of the layout.
+    void value(const nlohmann::json& json) {
+        if (!pretty()) {
+            output_ << json.dump();
+            return;
+        }
+        const auto text = json.dump(indentation_);
+        std::string_view rest(text);
+        for (auto pos = rest.find('\n'); pos != std::string_view::npos; pos = rest.find('\n')) {
+            output_ << rest.substr(0, pos);
+            newline();
+            rest.remove_prefix(pos + 1);
+        }
+        output_ << rest;
+    }
+
+private:
+    bool pretty() const noexcept { return indentation_ >= 0; }
+
+    void begin(char bracket) {
+        output_ << bracket;
+        ++depth_;
+    }
+
+    void end(char bracket) {
+        --depth_;
+        newline();
+        output_ << bracket;
+    }
+
+    void newline() {
+        if (pretty()) {
+            output_ << '\n';
+            for (int i = 0; i < depth_ * indentation_; ++i) {
+                output_ << ' ';
+            }
+        }
+    }
+
+    std::ostream& output_;
+    int indentation_;
+    int depth_{0};
+};
+
+namespace {
+// Elements of `items` in output order: as given, or stably sorted by
+// canonicalKey.
+template <typename T>
+std::vector<const T*> outputOrder(const std::vector<T>& items, bool canonicalOrder) {
+    std::vector<const T*> order;
+    order.reserve(items.size());
+    if (!canonicalOrder) {
+        for (const auto& item : items) {
+            order.push_back(&item);
+        }
+        return order;
+    }
+
+    std::vector<std::pair<nlohmann::json, const T*>> keyed;
+    keyed.reserve(items.size());
+    for (const auto& item : items) {
+        keyed.emplace_back(canonicalKey(item), &item);
+    }
+    std::stable_sort(keyed.begin(), keyed.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.first < rhs.first;
+    });
+    for (const auto& entry : keyed) {
+        order.push_back(entry.second);
+    }
+    return order;
+}
+} // namespace
+
+StreamingManifestSerializer::StreamingManifestSerializer(int indentation, bool canonicalOrder)
+    : indentation_(indentation), canonicalOrder_(canonicalOrder) {}
+
+void StreamingManifestSerializer::write(std::ostream& output, const core::ComponentList& components) const {
+    Writer writer(output, indentation_);
+
+    writer.beginObject();
+    writer.next(true);
+    writer.key("scr");
+    writer.beginObject();
+    writer.next(true);
+    writer.key("components");
+    if (components.empty()) {
+        output << "[]";
+    } else {
+        writer.beginArray();
+        bool firstComponent = true;
+        for (const auto* componentPtr : outputOrder(components, canonicalOrder_)) {
+            const auto& component = *componentPtr;
+            writer.next(firstComponent);
+            firstComponent = false;
+
+            // Members in the order JsonManifestBuilder assigns them, later
+            // assignments replacing earlier ones; a null value stands for
+            // the references array.
+            const nlohmann::json className = component.className();
+            nlohmann::json service;
+            std::map<std::string, const nlohmann::json*> members;
+            members["implementation-class"] = &className;
+
+            const auto& attributes = component.attributes();
+            bool serviceObject = false;
+            if (component.hasAttributes()) {
+                auto serviceIt = attributes.find("service");
+                serviceObject = serviceIt != attributes.end() && serviceIt->is_object();
+                if (serviceObject) {
+                    service = *serviceIt;
+                }
+            }
+            if (serviceObject || !component.interfaces().empty()) {
+                if (!component.interfaces().empty()) {
+                    service["interfaces"] = component.interfaces();
+                }
+                members["service"] = &service;
+            }
+            if (component.hasAttributes()) {
+                for (const auto& item : attributes.items()) {
+                    if (serviceObject && item.key() == "service") {
+                        continue;
+                    }
+                    members[item.key()] = &item.value();
+                }
+            }
+            if (component.hasProperties()) {
+                members["properties"] = &component.properties();
+            }
+            if (!component.references().empty()) {
+                members["references"] = nullptr;
+            }
+
+            writer.beginObject();
+            bool firstMember = true;
+            for (const auto& [name, value] : members) {
+                writer.next(firstMember);
+                firstMember = false;
+                writer.key(name);
+                if (value) {
+                    writer.value(*value);
+                    continue;
+                }
+
+                writer.beginArray();
+                bool firstReference = true;
+                for (const auto* referencePtr : outputOrder(component.references(), canonicalOrder_)) {
+                    const auto& reference = *referencePtr;
+                    writer.next(firstReference);
+                    firstReference = false;
+                    nlohmann::json referenceJson;
+                    referenceJson["name"] = reference.name();
+                    referenceJson["interface"] = reference.interface();
+                    if (reference.hasProperties()) {
+                        referenceJson.update(reference.properties());
+                    }
+                    writer.value(referenceJson);
+                }
+                writer.endArray();
+            }
+            writer.endObject();
+        }
+        writer.endArray();
+    }
+    writer.next(false);
+    writer.key("version");
+    writer.value(1);
+    writer.endObject();
+    writer.endObject();
+}
+
+} // namespace dsannotation::serialization
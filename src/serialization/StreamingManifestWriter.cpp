@@ -0,0 +1,44 @@
+#include "dsannotation/serialization/StreamingManifestWriter.h"
+
+#include <exception>
+
+#include "dsannotation/serialization/JsonManifestWriter.h"
+
+namespace dsannotation::serialization {
+
+StreamingManifestWriter::StreamingManifestWriter(const IManifestBuilder& builder,
+                                                 const IManifestMerger& merger,
+                                                 const support::IFileSystem& fileSystem,
+                                                 int indentation,
+                                                 bool canonicalOrder)
+    : builder_(builder),
+      merger_(merger),
+      fileSystem_(fileSystem),
+      indentation_(indentation),
+      canonicalOrder_(canonicalOrder),
+      serializer_(indentation, canonicalOrder) {}
+
+core::Result<bool> StreamingManifestWriter::writeManifest(const core::ComponentList& components,
+                                                          const std::string& existingManifestPath,
+                                                          const std::string& outputPath) const {
+    if (!existingManifestPath.empty() && fileSystem_.exists(existingManifestPath)) {
+        JsonManifestWriter domWriter(builder_, merger_, fileSystem_, indentation_, canonicalOrder_);
+        return domWriter.writeManifest(components, existingManifestPath, outputPath);
+    }
+
+    try {
+        const auto status = fileSystem_.writeTextStream(outputPath, [&](std::ostream& output) {
+            serializer_.write(output, components);
+            return static_cast<bool>(output);
+        });
+        if (status == support::WriteStatus::Failed) {
+            return core::Result<bool>::error("Failed to write manifest to " + outputPath);
+        }
+
+        return core::Result<bool>::success(status == support::WriteStatus::Written);
+    } catch (const std::exception& ex) {
+        return core::Result<bool>::error(ex.what());
+    }
+}
+
+} // namespace dsannotation::serialization
@@ -0,0 +1,182 @@
+#include "dsannotation/support/ByteScanner.h"
+
+#include <array>
+
+#if defined(__x86_64__) || defined(_M_X64) || (defined(__i386__) && defined(__SSE2__)) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define DSANNOTATION_X86_SIMD 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define DSANNOTATION_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define DSANNOTATION_TARGET_AVX2
+#endif
+
+namespace dsannotation::support {
+
+namespace {
+
+constexpr std::array<bool, 256> makeStructuralTable() {
+    std::array<bool, 256> table{};
+    for (unsigned c = 0; c < 0x20; ++c) {
+        table[c] = true;
+    }
+    table[0x7F] = true;
+    for (unsigned char c : {'{', '}', '[', ']', '(', ')', '"', '\'', '\\', '@'}) {
+        table[c] = true;
+    }
+    return table;
+}
+
+constexpr auto structuralTable = makeStructuralTable();
+
+unsigned countTrailingZeros(std::uint32_t mask) noexcept {
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return static_cast<unsigned>(index);
+#else
+    return static_cast<unsigned>(__builtin_ctz(mask));
+#endif
+}
+
+std::uint32_t classifyScalar(const char* block) noexcept {
+    std::uint32_t mask = 0;
+    for (std::size_t i = 0; i < kScanBlockSize; ++i) {
+        mask |= static_cast<std::uint32_t>(structuralTable[static_cast<unsigned char>(block[i])]) << i;
+    }
+    return mask;
+}
+
+#ifdef DSANNOTATION_X86_SIMD
+std::uint32_t classifySSE2Half(const char* block) noexcept {
+    const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block));
+    // Unsigned bytes <= 0x1F, or 0x7F
+    __m128i hits = _mm_cmpeq_epi8(_mm_max_epu8(bytes, _mm_set1_epi8(0x1F)), _mm_set1_epi8(0x1F));
+    hits = _mm_or_si128(hits, _mm_cmpeq_epi8(bytes, _mm_set1_epi8(0x7F)));
+    for (char c : {'{', '}', '[', ']', '(', ')', '"', '\'', '\\', '@'}) {
+        hits = _mm_or_si128(hits, _mm_cmpeq_epi8(bytes, _mm_set1_epi8(c)));
+    }
+    return static_cast<std::uint32_t>(_mm_movemask_epi8(hits));
+}
+
+std::uint32_t classifySSE2(const char* block) noexcept {
+    return classifySSE2Half(block) | (classifySSE2Half(block + 16) << 16);
+}
+
+DSANNOTATION_TARGET_AVX2
+std::uint32_t classifyAVX2(const char* block) noexcept {
+    const __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block));
+    __m256i hits = _mm256_cmpeq_epi8(_mm256_max_epu8(bytes, _mm256_set1_epi8(0x1F)), _mm256_set1_epi8(0x1F));
+    hits = _mm256_or_si256(hits, _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8(0x7F)));
+    for (char c : {'{', '}', '[', ']', '(', ')', '"', '\'', '\\', '@'}) {
+        hits = _mm256_or_si256(hits, _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8(c)));
+    }
+    return static_cast<std::uint32_t>(_mm256_movemask_epi8(hits));
+}
+
+bool cpuSupportsAVX2() noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#elif defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) {
+        return false;
+    }
+    __cpuid(info, 1);
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    const bool avx = (info[2] & (1 << 28)) != 0;
+    if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6) {
+        return false;
+    }
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    return false;
+#endif
+}
+#endif
+
+ScanKernel detectScanKernel() noexcept {
+#ifdef DSANNOTATION_X86_SIMD
+    return cpuSupportsAVX2() ? ScanKernel::AVX2 : ScanKernel::SSE2;
+#else
+    return ScanKernel::Scalar;
+#endif
+}
+
+} // namespace
+
+bool isStructuralByte(char c) noexcept {
+    return structuralTable[static_cast<unsigned char>(c)];
+}
+
+ScanKernel activeScanKernel() noexcept {
+    static const ScanKernel kernel = detectScanKernel();
+    return kernel;
+}
+
+bool isScanKernelSupported(ScanKernel kernel) noexcept {
+    switch (kernel) {
+    case ScanKernel::Scalar:
+        return true;
+    case ScanKernel::SSE2:
+#ifdef DSANNOTATION_X86_SIMD
+        return true;
+#else
+        return false;
+#endif
+    case ScanKernel::AVX2:
+        return activeScanKernel() == ScanKernel::AVX2;
+    }
+    return false;
+}
+
+std::uint32_t classifyBlock(const char* block, ScanKernel kernel) noexcept {
+    switch (kernel) {
+#ifdef DSANNOTATION_X86_SIMD
+    case ScanKernel::SSE2:
+        return classifySSE2(block);
+    case ScanKernel::AVX2:
+        return classifyAVX2(block);
+#endif
+    default:
+        return classifyScalar(block);
+    }
+}
+
+std::size_t findStructuralByte(std::string_view text, std::size_t from) noexcept {
+    return findStructuralByte(text, from, activeScanKernel());
+}
+
+std::size_t findStructuralByte(std::string_view text, std::size_t from, ScanKernel kernel) noexcept {
+    const char* data = text.data();
+    std::size_t position = from;
+
+    if (kernel != ScanKernel::Scalar) {
+        while (position + kScanBlockSize <= text.size()) {
+            const auto mask = classifyBlock(data + position, kernel);
+            if (mask != 0) {
+                return position + countTrailingZeros(mask);
+            }
+            position += kScanBlockSize;
+        }
+    }
+
+    // Tail shorter than a block, or the scalar kernel
+    for (; position < text.size(); ++position) {
+        if (structuralTable[static_cast<unsigned char>(data[position])]) {
+            return position;
+        }
+    }
+    return text.size();
+}
+
+} // namespace dsannotation::support
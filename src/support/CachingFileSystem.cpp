@@ -0,0 +1,85 @@
+#include "dsannotation/support/CachingFileSystem.h"
+
+namespace dsannotation::support {
+
+namespace {
+
+std::string cacheKey(const std::string& path) {
+    std::error_code error;
+    auto absolute = std::filesystem::absolute(path, error);
+    if (error) {
+        return path;
+    }
+    return absolute.lexically_normal().generic_string();
+}
+
+} // namespace
+
+CachingFileSystem::CachingFileSystem(const IFileSystem& inner)
+    : inner_(inner) {}
+
+bool CachingFileSystem::exists(const std::string& path) const {
+    return inner_.exists(path);
+}
+
+std::optional<std::string> CachingFileSystem::readTextFile(const std::string& path) const {
+    return inner_.readTextFile(path);
+}
+
+std::optional<nlohmann::json> CachingFileSystem::readJsonFile(const std::string& path) const {
+    const auto key = cacheKey(path);
+    std::error_code error;
+    const auto modified = std::filesystem::last_write_time(key, error);
+    const auto size = error ? 0 : std::filesystem::file_size(key, error);
+    if (error) {
+        // Missing or special files are not worth remembering
+        return inner_.readJsonFile(path);
+    }
+    const Stamp stamp{modified, size};
+
+    auto& entry = slot(key);
+    std::lock_guard<std::mutex> lock(entry.mutex);
+    if (entry.stamp && *entry.stamp == stamp) {
+        ++hits_;
+    } else {
+        ++misses_;
+        auto json = inner_.readJsonFile(path);
+        entry.json = json ? std::make_shared<const nlohmann::json>(std::move(*json)) : nullptr;
+        entry.stamp = stamp;
+    }
+
+    if (!entry.json) {
+        return std::nullopt;
+    }
+    return *entry.json;
+}
+
+WriteStatus CachingFileSystem::writeTextFile(const std::string& path, const std::string& contents) const {
+    return inner_.writeTextFile(path, contents);
+}
+
+WriteStatus CachingFileSystem::writeTextStream(const std::string& path,
+                                               const std::function<bool(std::ostream&)>& write) const {
+    return inner_.writeTextStream(path, write);
+}
+
+WriteStatus CachingFileSystem::writeBinaryFile(const std::string& path, std::string_view contents) const {
+    return inner_.writeBinaryFile(path, contents);
+}
+
+CachingFileSystem::Slot& CachingFileSystem::slot(const std::string& key) const {
+    {
+        std::shared_lock lock(mutex_);
+        if (auto it = slots_.find(key); it != slots_.end()) {
+            return *it->second;
+        }
+    }
+    std::unique_lock lock(mutex_);
+    auto& slot = slots_[key];
+    if (!slot) {
+        slot = std::make_unique<Slot>();
+    }
+    return *slot;
+}
+
+} // namespace dsannotation::support
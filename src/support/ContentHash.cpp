@@ -0,0 +1,39 @@
+#include "dsannotation/support/ContentHash.h"
+
+namespace dsannotation::support {
+
+namespace {
+constexpr std::uint64_t kFnvPrime = 1099511628211ULL;
+}
+
+ContentHasher& ContentHasher::update(std::string_view data) noexcept {
+    for (unsigned char c : data) {
+        state_ ^= c;
+        state_ *= kFnvPrime;
+    }
+    return *this;
+}
+
+ContentHasher& ContentHasher::update(std::uint64_t value) noexcept {
+    for (int i = 0; i < 8; ++i) {
+        state_ ^= static_cast<unsigned char>(value >> (i * 8));
+        state_ *= kFnvPrime;
+    }
+    return *this;
+}
+
+std::uint64_t hashContent(std::string_view data) noexcept {
+    return ContentHasher().update(data).digest();
+}
+
+std::string toHex(std::uint64_t digest) {
+    static constexpr char kDigits[] = "0123456789abcdef";
+    std::string hex(16, '0');
+    for (int i = 15; i >= 0; --i) {
+        hex[i] = kDigits[digest & 0xF];
+        digest >>= 4;
+    }
+    return hex;
+}
+
+} // namespace dsannotation::support
@@ -6,13 +6,15 @@
 namespace dsannotation::support {
 
 ErrorReporter::ErrorReporter(const core::ErrorCollector& collector)
-    : collector_(collector) {}
+    : errors_(collector.errors()) {}
+
+ErrorReporter::ErrorReporter(const std::vector<core::Error>& errors)
+    : errors_(errors) {}
 
 std::string ErrorReporter::summary() const {
     std::ostringstream builder;
     builder << "Following errors occurred during parsing annotations:\n\n";
-    const auto& errors = collector_.errors();
-    for (const auto& error : errors) {
+    for (const auto& error : errors_) {
         builder << "Error: " << error.message << '\n';
         if (!error.location.empty()) {
             builder << "Location: " << error.location << '\n';
@@ -20,7 +22,7 @@ std::string ErrorReporter::summary() const {
         builder << "Severity: " << static_cast<int>(error.severity) << '\n';
         builder << "Category: " << static_cast<int>(error.category) << "\n\n";
     }
-    builder << "Total errors: " << errors.size() << "\n";
+    builder << "Total errors: " << errors_.size() << "\n";
     return builder.str();
 }
 
@@ -1,12 +1,159 @@
 #include "dsannotation/support/LocalFileSystem.h"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <fstream>
+#include <functional>
 #include <sstream>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "dsannotation/support/ContentHash.h"
 
 namespace dsannotation::support {
 
+namespace {
+
+constexpr std::size_t kChunkSize = 64 * 1024;
+
+// True if the file at `path`, read back in `mode`, holds exactly `contents`.
+// Binary files of a different size are rejected without reading them.
+bool hasContents(const std::string& path, std::string_view contents, std::ios::openmode mode = std::ios::in) {
+    std::error_code error;
+    if ((mode & std::ios::binary) && std::filesystem::file_size(path, error) != contents.size()) {
+        return false;
+    }
+    std::ifstream input(path, mode | std::ios::in);
+    if (!input.is_open()) {
+        return false;
+    }
+    std::vector<char> buffer(kChunkSize);
+    std::size_t offset = 0;
+    while (input.read(buffer.data(), static_cast<std::streamsize>(buffer.size())) || input.gcount() > 0) {
+        const auto count = static_cast<std::size_t>(input.gcount());
+        if (count > contents.size() - offset ||
+            std::string_view(buffer.data(), count) != contents.substr(offset, count)) {
+            return false;
+        }
+        offset += count;
+    }
+    return !input.bad() && offset == contents.size();
+}
+
+// True if both files have the same size and bytes
+bool sameFiles(const std::filesystem::path& lhs, const std::filesystem::path& rhs) {
+    std::error_code error;
+    const auto size = std::filesystem::file_size(lhs, error);
+    if (error || std::filesystem::file_size(rhs, error) != size || error) {
+        return false;
+    }
+    std::ifstream left(lhs, std::ios::binary);
+    std::ifstream right(rhs, std::ios::binary);
+    if (!left.is_open() || !right.is_open()) {
+        return false;
+    }
+    std::vector<char> leftBuffer(kChunkSize);
+    std::vector<char> rightBuffer(kChunkSize);
+    while (left.read(leftBuffer.data(), static_cast<std::streamsize>(leftBuffer.size())) || left.gcount() > 0) {
+        const auto count = left.gcount();
+        if (!right.read(rightBuffer.data(), count) ||
+            !std::equal(leftBuffer.begin(), leftBuffer.begin() + count, rightBuffer.begin())) {
+            return false;
+        }
+    }
+    return !left.bad() && right.peek() == std::ifstream::traits_type::eof();
+}
+
+std::filesystem::path temporarySibling(const std::filesystem::path& path) {
+    static std::atomic<std::uint64_t> counter{0};
+    const auto unique = ContentHasher()
+                            .update(static_cast<std::uint64_t>(std::hash<std::thread::id>{}(std::this_thread::get_id())))
+                            .update(static_cast<std::uint64_t>(
+                                std::chrono::steady_clock::now().time_since_epoch().count()))
+                            .update(counter++)
+                            .digest();
+    auto temporary = path;
+    temporary += ".tmp-" + toHex(unique);
+    return temporary;
+}
+
+// Writes to a temporary file next to `path` and renames it into place, so
+// readers never observe a partially written file. With `skipIfUnchanged`
+// the temporary file is dropped when its contents match the existing file.
+// A symlinked `path` keeps the link and replaces the file it points to; the
+// replaced file's permission bits carry over, its owner and hard links do
+// not.
+WriteStatus replaceFile(const std::string& path,
+                        const std::function<bool(std::ostream&)>& write,
+                        bool skipIfUnchanged,
+                        std::ios::openmode mode = std::ios::out) {
+    std::error_code error;
+    std::filesystem::path target(path);
+    if (std::filesystem::is_symlink(target, error)) {
+        auto resolved = std::filesystem::weakly_canonical(target, error);
+        if (!error) {
+            target = std::move(resolved);
+        }
+    }
+    if (target.has_parent_path()) {
+        std::filesystem::create_directories(target.parent_path(), error);
+        if (error) {
+            return WriteStatus::Failed;
+        }
+    }
+    const auto temporary = temporarySibling(target);
+
+    {
+        // Large writes go straight to the file in 64 KiB chunks
+        std::vector<char> buffer(kChunkSize);
+        std::ofstream output;
+        output.rdbuf()->pubsetbuf(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        output.open(temporary, mode | std::ios::out);
+        if (!output.is_open()) {
+            return WriteStatus::Failed;
+        }
+
+        bool written = false;
+        try {
+            written = write(output) && output.flush();
+        } catch (...) {
+            output.close();
+            std::filesystem::remove(temporary, error);
+            throw;
+        }
+        output.close();
+        if (!written || !output) {
+            std::filesystem::remove(temporary, error);
+            return WriteStatus::Failed;
+        }
+    }
+
+    if (skipIfUnchanged && sameFiles(temporary, target)) {
+        std::filesystem::remove(temporary, error);
+        return WriteStatus::Unchanged;
+    }
+
+    const auto existing = std::filesystem::status(target, error);
+    if (!error && std::filesystem::exists(existing)) {
+        std::filesystem::permissions(temporary, existing.permissions(), error);
+    }
+
+    std::filesystem::rename(temporary, target, error);
+    if (error) {
+        std::filesystem::remove(temporary, error);
+        return WriteStatus::Failed;
+    }
+    return WriteStatus::Written;
+}
+
+} // namespace
+
 bool LocalFileSystem::exists(const std::string& path) const {
-    return std::filesystem::exists(path);
+    std::error_code error;
+    return std::filesystem::exists(path, error);
 }
 
 std::optional<std::string> LocalFileSystem::readTextFile(const std::string& path) const {
@@ -31,19 +178,34 @@ std::optional<nlohmann::json> LocalFileSystem::readJsonFile(const std::string& p
     return json;
 }
 
-bool LocalFileSystem::writeTextFile(const std::string& path, const std::string& contents) const {
-    auto parent = std::filesystem::path(path).parent_path();
-    if (!parent.empty()) {
-        std::filesystem::create_directories(parent);
+WriteStatus LocalFileSystem::writeTextFile(const std::string& path, const std::string& contents) const {
+    if (hasContents(path, contents)) {
+        return WriteStatus::Unchanged;
     }
+    return replaceFile(path,
+                       [&](std::ostream& output) {
+                           output << contents;
+                           return true;
+                       },
+                       false);
+}
 
-    std::ofstream output(path);
-    if (!output.is_open()) {
-        return false;
-    }
+WriteStatus LocalFileSystem::writeTextStream(const std::string& path,
+                                             const std::function<bool(std::ostream&)>& write) const {
+    return replaceFile(path, write, true);
+}
 
-    output << contents;
-    return static_cast<bool>(output);
+WriteStatus LocalFileSystem::writeBinaryFile(const std::string& path, std::string_view contents) const {
+    if (hasContents(path, contents, std::ios::binary)) {
+        return WriteStatus::Unchanged;
+    }
+    return replaceFile(path,
+                       [&](std::ostream& output) {
+                           output.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+                           return true;
+                       },
+                       false,
+                       std::ios::binary);
 }
 
 } // namespace dsannotation::support
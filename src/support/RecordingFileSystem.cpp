@@ -0,0 +1,66 @@
+#include "dsannotation/support/RecordingFileSystem.h"
+
+#include <algorithm>
+
+namespace dsannotation::support {
+
+RecordingFileSystem::RecordingFileSystem(const IFileSystem& inner)
+    : inner_(inner) {}
+
+bool RecordingFileSystem::exists(const std::string& path) const {
+    return inner_.exists(path);
+}
+
+std::optional<std::string> RecordingFileSystem::readTextFile(const std::string& path) const {
+    record(path);
+    return inner_.readTextFile(path);
+}
+
+std::optional<nlohmann::json> RecordingFileSystem::readJsonFile(const std::string& path) const {
+    record(path);
+    return inner_.readJsonFile(path);
+}
+
+WriteStatus RecordingFileSystem::writeTextFile(const std::string& path, const std::string& contents) const {
+    return inner_.writeTextFile(path, contents);
+}
+
+WriteStatus RecordingFileSystem::writeTextStream(const std::string& path,
+                                                 const std::function<bool(std::ostream&)>& write) const {
+    return inner_.writeTextStream(path, write);
+}
+
+WriteStatus RecordingFileSystem::writeBinaryFile(const std::string& path, std::string_view contents) const {
+    return inner_.writeBinaryFile(path, contents);
+}
+
+std::vector<std::string> RecordingFileSystem::readPaths() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return readPaths_;
+}
+
+std::size_t RecordingFileSystem::readCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return readLog_.size();
+}
+
+std::vector<std::string> RecordingFileSystem::readPathsSince(std::size_t readCount) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<std::string> paths;
+    for (auto i = std::min(readCount, readLog_.size()); i < readLog_.size(); ++i) {
+        if (std::find(paths.begin(), paths.end(), readLog_[i]) == paths.end()) {
+            paths.push_back(readLog_[i]);
+        }
+    }
+    return paths;
+}
+
+void RecordingFileSystem::record(const std::string& path) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    readLog_.push_back(path);
+    if (std::find(readPaths_.begin(), readPaths_.end(), path) == readPaths_.end()) {
+        readPaths_.push_back(path);
+    }
+}
+
+} // namespace dsannotation::support
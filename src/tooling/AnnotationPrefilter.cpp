@@ -0,0 +1,385 @@
+#include "dsannotation/tooling/AnnotationPrefilter.h"
+
+#include <cstdlib>
+#include <filesystem>
+#include <system_error>
+
+#include "dsannotation/support/ContentHash.h"
+#include "dsannotation/support/MappedFile.h"
+#include "dsannotation/tooling/ScanProfile.h"
+
+namespace dsannotation::tooling {
+
+namespace {
+constexpr std::string_view kMarker = "@component";
+
+std::string normalize(const std::filesystem::path& path) {
+    return path.lexically_normal().string();
+}
+
+std::string absoluteIn(const std::string& directory, const std::string& path) {
+    std::filesystem::path candidate(path);
+    if (candidate.is_absolute()) {
+        return normalize(candidate);
+    }
+    return normalize(std::filesystem::path(directory) / candidate);
+}
+
+bool isRegularFile(const std::string& path) {
+    std::error_code error;
+    return std::filesystem::is_regular_file(path, error);
+}
+
+bool isSpace(char c) {
+    return c == ' ' || c == '\t';
+}
+
+// Directories of a CPATH-style environment variable
+void appendEnvironmentPaths(const char* variable, const std::string& directory, std::vector<std::string>& paths) {
+    const char* value = std::getenv(variable);
+    if (!value) {
+        return;
+    }
+#ifdef _WIN32
+    constexpr char kSeparator = ';';
+#else
+    constexpr char kSeparator = ':';
+#endif
+    std::string_view rest(value);
+    while (!rest.empty()) {
+        const auto end = rest.find(kSeparator);
+        const auto entry = rest.substr(0, end);
+        // An empty entry stands for the current directory
+        paths.push_back(absoluteIn(directory, entry.empty() ? "." : std::string(entry)));
+        if (end == std::string_view::npos) {
+            break;
+        }
+        rest.remove_prefix(end + 1);
+    }
+}
+} // namespace
+
+AnnotationPrefilter::AnnotationPrefilter(bool followSystemHeaders)
+    : followSystemHeaders_(followSystemHeaders) {}
+
+bool AnnotationPrefilter::containsMarker(std::string_view text) noexcept {
+    return text.find(kMarker) != std::string_view::npos;
+}
+
+bool AnnotationPrefilter::mayContainComponents(const std::vector<clang::tooling::CompileCommand>& commands) const {
+    if (commands.empty()) {
+        return true;
+    }
+    for (const auto& command : commands) {
+        if (mayContainComponents(command)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool AnnotationPrefilter::mayContainComponents(const clang::tooling::CompileCommand& command) const {
+    const auto paths = parseSearchPaths(command);
+    if (paths.usesPrecompiledHeader) {
+        return true;
+    }
+
+    std::vector<std::string> pending;
+    pending.push_back(absoluteIn(command.Directory, command.Filename));
+    for (auto it = paths.forcedIncludes.rbegin(); it != paths.forcedIncludes.rend(); ++it) {
+        pending.push_back(*it);
+    }
+
+    std::unordered_set<std::string> visited;
+    while (!pending.empty()) {
+        auto path = std::move(pending.back());
+        pending.pop_back();
+        if (!visited.insert(path).second) {
+            continue;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (cleanClosures_.count(paths.fingerprint + path) != 0) {
+                continue;
+            }
+        }
+
+        auto scan = scanFile(path);
+        if (!scan || scan->hasMarker || scan->hasComputedInclude || scan->hasIncludeNext) {
+            return true;
+        }
+
+        const auto directory = std::filesystem::path(path).parent_path().string();
+        for (const auto& include : scan->includes) {
+            auto resolved = resolve(include, directory, paths);
+            if (!resolved) {
+                // A quoted include we cannot find may be generated or come
+                // from a path we do not model; let Clang decide. An angled
+                // one is taken for an implicit system header.
+                if (!include.angled || followSystemHeaders_) {
+                    return true;
+                }
+                continue;
+            }
+            if (!resolved->isSystem || followSystemHeaders_) {
+                pending.push_back(std::move(resolved->path));
+            }
+        }
+    }
+
+    // Every file visited from a marker-free root has a marker-free closure.
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& path : visited) {
+        cleanClosures_.insert(paths.fingerprint + path);
+    }
+    return false;
+}
+
+AnnotationPrefilter::SearchPaths AnnotationPrefilter::parseSearchPaths(const clang::tooling::CompileCommand& command) {
+    SearchPaths paths;
+    const auto& arguments = command.CommandLine;
+    if (arguments.empty()) {
+        return paths;
+    }
+
+    // '/I' style options are only meaningful for cl-compatible drivers; for
+    // other drivers they would be absolute paths.
+    const bool msvcStyle = isMsvcDriver(arguments.front());
+
+    auto takeValue = [&](std::size_t& i, std::string_view argument, std::string_view flag) -> std::optional<std::string> {
+        if (argument.size() > flag.size()) {
+            return std::string(argument.substr(flag.size()));
+        }
+        if (i + 1 < arguments.size()) {
+            return arguments[++i];
+        }
+        return std::nullopt;
+    };
+
+    for (std::size_t i = 1; i < arguments.size(); ++i) {
+        std::string_view argument = arguments[i];
+        if (argument.rfind("-include-pch", 0) == 0 || (msvcStyle && argument.rfind("/Yu", 0) == 0)) {
+            paths.usesPrecompiledHeader = true;
+        } else if (argument.rfind("-iquote", 0) == 0) {
+            if (auto value = takeValue(i, argument, "-iquote")) {
+                paths.quoted.push_back(absoluteIn(command.Directory, *value));
+            }
+        } else if (argument.rfind("-isystem", 0) == 0) {
+            if (auto value = takeValue(i, argument, "-isystem")) {
+                paths.system.push_back(absoluteIn(command.Directory, *value));
+            }
+        } else if (argument.rfind("-idirafter", 0) == 0) {
+            if (auto value = takeValue(i, argument, "-idirafter")) {
+                paths.system.push_back(absoluteIn(command.Directory, *value));
+            }
+        } else if (argument.rfind("-iframework", 0) == 0) {
+            if (auto value = takeValue(i, argument, "-iframework")) {
+                paths.systemFrameworks.push_back(absoluteIn(command.Directory, *value));
+            }
+        } else if (argument.rfind("-imsvc", 0) == 0) {
+            if (auto value = takeValue(i, argument, "-imsvc")) {
+                paths.system.push_back(absoluteIn(command.Directory, *value));
+            }
+        } else if (msvcStyle && (argument.rfind("/imsvc", 0) == 0)) {
+            if (auto value = takeValue(i, argument, "/imsvc")) {
+                paths.system.push_back(absoluteIn(command.Directory, *value));
+            }
+        } else if (msvcStyle && (argument.rfind("/external:I", 0) == 0 || argument.rfind("-external:I", 0) == 0)) {
+            if (auto value = takeValue(i, argument, "/external:I")) {
+                paths.system.push_back(absoluteIn(command.Directory, *value));
+            }
+        } else if (argument.rfind("--include-directory=", 0) == 0) {
+            paths.angled.push_back(absoluteIn(command.Directory,
+                                              std::string(argument.substr(std::string_view("--include-directory=").size()))));
+        } else if (argument == "--include-directory") {
+            if (auto value = takeValue(i, argument, argument)) {
+                paths.angled.push_back(absoluteIn(command.Directory, *value));
+            }
+        } else if (!msvcStyle && argument.rfind("-F", 0) == 0) {
+            if (auto value = takeValue(i, argument, "-F")) {
+                paths.frameworks.push_back(absoluteIn(command.Directory, *value));
+            }
+        } else if (argument.rfind("-include", 0) == 0) {
+            if (auto value = takeValue(i, argument, "-include")) {
+                paths.forcedIncludes.push_back(absoluteIn(command.Directory, *value));
+            }
+        } else if (msvcStyle && argument.rfind("/FI", 0) == 0) {
+            if (auto value = takeValue(i, argument, "/FI")) {
+                paths.forcedIncludes.push_back(absoluteIn(command.Directory, *value));
+            }
+        } else if (argument.rfind("-I", 0) == 0) {
+            if (auto value = takeValue(i, argument, "-I")) {
+                paths.angled.push_back(absoluteIn(command.Directory, *value));
+            }
+        } else if (msvcStyle && argument.rfind("/I", 0) == 0) {
+            if (auto value = takeValue(i, argument, "/I")) {
+                paths.angled.push_back(absoluteIn(command.Directory, *value));
+            }
+        }
+    }
+
+    // Environment directories are searched after the command line's
+    appendEnvironmentPaths("CPATH", command.Directory, paths.angled);
+    appendEnvironmentPaths("C_INCLUDE_PATH", command.Directory, paths.system);
+    appendEnvironmentPaths("CPLUS_INCLUDE_PATH", command.Directory, paths.system);
+
+    support::ContentHasher hasher;
+    for (const auto* list : {&paths.quoted, &paths.angled, &paths.system, &paths.frameworks, &paths.systemFrameworks}) {
+        for (const auto& directory : *list) {
+            hasher.update(directory).update(std::string_view("\0", 1));
+        }
+        hasher.update(std::string_view("\1", 1));
+    }
+    paths.fingerprint = support::toHex(hasher.digest()) + "|";
+    return paths;
+}
+
+AnnotationPrefilter::FileScan AnnotationPrefilter::scanContents(std::string_view text) {
+    FileScan scan;
+    if (containsMarker(text)) {
+        scan.hasMarker = true;
+        return scan;
+    }
+
+    std::size_t lineStart = 0;
+    while (lineStart < text.size()) {
+        auto lineEnd = text.find('\n', lineStart);
+        if (lineEnd == std::string_view::npos) {
+            lineEnd = text.size();
+        }
+        auto line = text.substr(lineStart, lineEnd - lineStart);
+        lineStart = lineEnd + 1;
+
+        std::size_t pos = 0;
+        while (pos < line.size() && isSpace(line[pos])) {
+            ++pos;
+        }
+        if (pos >= line.size() || line[pos] != '#') {
+            continue;
+        }
+        ++pos;
+        while (pos < line.size() && isSpace(line[pos])) {
+            ++pos;
+        }
+
+        auto directive = line.substr(pos);
+        // #include_next continues the search after the directory the
+        // includer was found in, which is not tracked here; the header it
+        // names is usually another file of the same name.
+        if (directive.rfind("include_next", 0) == 0) {
+            scan.hasIncludeNext = true;
+            continue;
+        }
+        std::size_t keywordLength = 0;
+        for (std::string_view keyword : {"include", "import"}) {
+            if (directive.rfind(keyword, 0) == 0) {
+                keywordLength = keyword.size();
+                break;
+            }
+        }
+        if (keywordLength == 0) {
+            continue;
+        }
+
+        pos += keywordLength;
+        while (pos < line.size() && isSpace(line[pos])) {
+            ++pos;
+        }
+        if (pos >= line.size()) {
+            continue;
+        }
+
+        const char open = line[pos];
+        const char close = open == '"' ? '"' : (open == '<' ? '>' : '\0');
+        const auto end = close ? line.find(close, pos + 1) : std::string_view::npos;
+        if (end == std::string_view::npos) {
+            scan.hasComputedInclude = true;
+            continue;
+        }
+        scan.includes.push_back(IncludeDirective{std::string(line.substr(pos + 1, end - pos - 1)), open == '<'});
+    }
+
+    return scan;
+}
+
+std::shared_ptr<const AnnotationPrefilter::FileScan> AnnotationPrefilter::scanFile(const std::string& path) const {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (auto it = scans_.find(path); it != scans_.end()) {
+            return it->second;
+        }
+    }
+
+    std::shared_ptr<const FileScan> scan;
+    if (auto mapped = support::MappedFile::open(path)) {
+        scan = std::make_shared<const FileScan>(scanContents(mapped->contents()));
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    scans_.emplace(path, scan);
+    return scan;
+}
+
+std::optional<AnnotationPrefilter::ResolvedInclude> AnnotationPrefilter::resolve(const IncludeDirective& include,
+                                                                                 const std::string& includerDirectory,
+                                                                                 const SearchPaths& paths) const {
+    std::string key = paths.fingerprint + (include.angled ? "<" : "\"") + includerDirectory + "|" + include.name;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (auto it = resolutions_.find(key); it != resolutions_.end()) {
+            return it->second;
+        }
+    }
+
+    std::optional<ResolvedInclude> resolved;
+    auto tryDirectories = [&](const std::vector<std::string>& directories, bool isSystem) {
+        for (const auto& directory : directories) {
+            auto candidate = absoluteIn(directory, include.name);
+            if (isRegularFile(candidate)) {
+                resolved = ResolvedInclude{std::move(candidate), isSystem};
+                return true;
+            }
+        }
+        return false;
+    };
+
+    // <Name/Header.h> in a framework directory
+    auto tryFrameworks = [&](const std::vector<std::string>& directories, bool isSystem) {
+        const auto slash = include.name.find('/');
+        if (slash == std::string::npos) {
+            return false;
+        }
+        const auto framework = include.name.substr(0, slash) + ".framework";
+        for (const auto& directory : directories) {
+            auto candidate = normalize(std::filesystem::path(directory) / framework / "Headers" /
+                                       include.name.substr(slash + 1));
+            if (isRegularFile(candidate)) {
+                resolved = ResolvedInclude{std::move(candidate), isSystem};
+                return true;
+            }
+        }
+        return false;
+    };
+
+    if (std::filesystem::path(include.name).is_absolute()) {
+        if (isRegularFile(include.name)) {
+            resolved = ResolvedInclude{normalize(include.name), false};
+        }
+    } else {
+        // Quoted includes search the includer's directory and -iquote
+        // first, then fall back to the angled search order.
+        const bool found = (!include.angled && (tryDirectories({includerDirectory}, false) ||
+                                                tryDirectories(paths.quoted, false))) ||
+                           tryDirectories(paths.angled, false) || tryFrameworks(paths.frameworks, false);
+        if (!found && !tryDirectories(paths.system, true)) {
+            tryFrameworks(paths.systemFrameworks, true);
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    resolutions_.emplace(std::move(key), resolved);
+    return resolved;
+}
+
+} // namespace dsannotation::tooling
@@ -0,0 +1,125 @@
+#include "dsannotation/tooling/ComponentAction.h"
+
+#include <algorithm>
+
+#include "clang/AST/ASTContext.h"
+#include "clang/Basic/FileManager.h"
+#include "clang/Frontend/CompilerInstance.h"
+#include "clang/Lex/Preprocessor.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/Support/Path.h"
+
+#include "dsannotation/core/ErrorCollector.h"
+#include "dsannotation/parsing/ASTVisitor.h"
+#include "dsannotation/parsing/CommentDrivenDiscovery.h"
+#include "dsannotation/parsing/ComponentCollector.h"
+#include "dsannotation/parsing/ComponentParser.h"
+#include "dsannotation/parsing/LocationFilter.h"
+#include "dsannotation/parsing/PropertyParser.h"
+#include "dsannotation/parsing/ReferenceParser.h"
+#include "dsannotation/support/LocalFileSystem.h"
+#include "dsannotation/support/RecordingFileSystem.h"
+
+namespace dsannotation::tooling {
+
+namespace {
+// Records `path` once, made absolute against the file manager's working
+// directory: the compile command's directory the file was opened from.
+void addDependency(std::vector<std::string>& dependencies,
+                   const clang::FileManager& fileManager,
+                   llvm::StringRef path) {
+    llvm::SmallString<256> absolute(path);
+    fileManager.makeAbsolutePath(absolute);
+    llvm::sys::path::remove_dots(absolute, /*remove_dot_dot=*/true);
+    std::string resolved = absolute.str().str();
+    if (std::find(dependencies.begin(), dependencies.end(), resolved) == dependencies.end()) {
+        dependencies.push_back(std::move(resolved));
+    }
+}
+} // namespace
+
+ComponentASTConsumer::ComponentASTConsumer(const ScanSession& session,
+                                           TranslationUnitResult& result,
+                                           std::shared_ptr<clang::DependencyCollector> dependencies)
+    : session_(session), result_(result), dependencies_(std::move(dependencies)) {}
+
+void ComponentASTConsumer::HandleTranslationUnit(clang::ASTContext& context) {
+    support::LocalFileSystem localFileSystem;
+    support::RecordingFileSystem fileSystem(session_.propertyFileSystem ? *session_.propertyFileSystem
+                                                                        : localFileSystem);
+    parsing::PropertyParser propertyParser;
+    parsing::ReferenceParser referenceParser(propertyParser);
+    core::ErrorCollector errorCollector(context.getSourceManager());
+
+    parsing::ComponentParser componentParser(propertyParser,
+                                             referenceParser,
+                                             fileSystem,
+                                             errorCollector,
+                                             session_.config,
+                                             session_.validationCache);
+
+    parsing::ComponentCollector collector(context, componentParser, errorCollector, session_.registry, &fileSystem);
+    parsing::LocationFilter locationFilter(context.getSourceManager(), session_.config);
+    if (session_.config.discoveryMode == config::DiscoveryMode::Comments) {
+        parsing::CommentDrivenDiscovery discovery(context, collector, &locationFilter);
+        discovery.discover();
+    } else {
+        const auto scope = session_.config.discoveryMode == config::DiscoveryMode::Contexts
+                               ? parsing::TraversalScope::Declarations
+                               : parsing::TraversalScope::Full;
+        parsing::ASTVisitor visitor(collector, scope, &locationFilter);
+        visitor.TraverseDecl(context.getTranslationUnitDecl());
+    }
+
+    if (const auto* names = componentParser.interfaceNameCache()) {
+        result_.interfaceNameHits += names->hits();
+        result_.interfaceNameLookups += names->hits() + names->misses();
+    }
+
+    const auto& components = collector.components();
+    result_.components.insert(result_.components.end(), components.begin(), components.end());
+    const auto& errors = errorCollector.errors();
+    result_.errors.insert(result_.errors.end(), errors.begin(), errors.end());
+
+    const auto& fileManager = context.getSourceManager().getFileManager();
+    for (const auto& dependency : dependencies_->getDependencies()) {
+        addDependency(result_.dependencies, fileManager, dependency);
+    }
+    for (const auto& path : fileSystem.readPaths()) {
+        addDependency(result_.dependencies, fileManager, path);
+    }
+    for (const auto& path : collector.dependencies()) {
+        addDependency(result_.dependencies, fileManager, path);
+    }
+}
+
+ComponentAction::ComponentAction(const ScanSession& session, TranslationUnitResult& result)
+    : session_(session), result_(result) {}
+
+bool ComponentAction::BeginInvocation(clang::CompilerInstance& CI) {
+    if (session_.config.scanProfile == config::ScanProfile::Declarations) {
+        // Only declarations, constructor signatures and doc comments are
+        // needed; bodies are skipped by the parser and never reach Sema.
+        CI.getFrontendOpts().SkipFunctionBodies = true;
+    }
+    return true;
+}
+
+std::unique_ptr<clang::ASTConsumer> ComponentAction::CreateASTConsumer(clang::CompilerInstance& CI,
+                                                                       llvm::StringRef) {
+    // The preprocessor exists but has not entered the main file yet, so the
+    // collector sees the main file and every user header it includes.
+    auto dependencies = std::make_shared<clang::DependencyCollector>();
+    dependencies->attachToPreprocessor(CI.getPreprocessor());
+    return std::make_unique<ComponentASTConsumer>(session_, result_, std::move(dependencies));
+}
+
+ComponentActionFactory::ComponentActionFactory(const ScanSession& session,
+                                               TranslationUnitResult& result)
+    : session_(session), result_(result) {}
+
+std::unique_ptr<clang::FrontendAction> ComponentActionFactory::create() {
+    return std::make_unique<ComponentAction>(session_, result_);
+}
+
+} // namespace dsannotation::tooling
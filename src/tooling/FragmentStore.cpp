@@ -0,0 +1,51 @@
+#include "dsannotation/tooling/FragmentStore.h"
+
+#include <exception>
+#include <filesystem>
+
+#include "dsannotation/serialization/ComponentFragment.h"
+#include "dsannotation/support/ContentHash.h"
+#include "dsannotation/support/MappedFile.h"
+
+namespace dsannotation::tooling {
+
+FragmentStore::FragmentStore(std::string directory,
+                             const support::IFileSystem& fileSystem,
+                             std::uint64_t runIdentity,
+                             config::ShardSpec shard)
+    : directory_(std::move(directory)), fileSystem_(fileSystem), runIdentity_(runIdentity), shard_(shard) {}
+
+bool FragmentStore::store(const TranslationUnitResult& result) const {
+    try {
+        return storeFragment(result);
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
+bool FragmentStore::storeFragment(const TranslationUnitResult& result) const {
+    auto source = support::MappedFile::open(result.sourcePath);
+    if (!source) {
+        return false;
+    }
+
+    serialization::ComponentFragment fragment;
+    fragment.sourcePath = result.sourcePath;
+    fragment.sourceFingerprint = support::hashContent(source->contents());
+    fragment.ordinal = result.ordinal;
+    fragment.runIdentity = runIdentity_;
+    fragment.shardIndex = shard_.index;
+    fragment.shardCount = shard_.count;
+    fragment.components = result.components;
+
+    return fileSystem_.writeBinaryFile(fragmentPath(result.sourcePath),
+                                       serialization::encodeFragment(fragment)) != support::WriteStatus::Failed;
+}
+
+std::string FragmentStore::fragmentPath(const std::string& sourcePath) const {
+    std::filesystem::path path(directory_);
+    path /= support::toHex(support::hashContent(sourcePath)) + std::string(serialization::kFragmentExtension);
+    return path.string();
+}
+
+} // namespace dsannotation::tooling
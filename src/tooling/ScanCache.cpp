@@ -0,0 +1,159 @@
+#include "dsannotation/tooling/ScanCache.h"
+
+#include <exception>
+#include <filesystem>
+#include <string_view>
+
+#include "dsannotation/serialization/ComponentCodec.h"
+#include "dsannotation/support/ContentHash.h"
+
+namespace dsannotation::tooling {
+
+#ifndef DSANNOTATION_BUILD_ID
+#define DSANNOTATION_BUILD_ID ""
+#endif
+
+namespace {
+// Part of every entry's key, together with the build identifier. Bump it
+// with every change to what a scan reports (components, attributes,
+// diagnostics), so a cache kept across upgrades never serves results of an
+// older parser.
+constexpr int kCacheFormatVersion = 2;
+constexpr std::string_view kBuildId = DSANNOTATION_BUILD_ID;
+
+nlohmann::json encodeErrors(const std::vector<core::Error>& errors) {
+    nlohmann::json json = nlohmann::json::array();
+    for (const auto& error : errors) {
+        json.push_back({{"message", error.message},
+                        {"location", error.location},
+                        {"severity", static_cast<int>(error.severity)},
+                        {"category", static_cast<int>(error.category)}});
+    }
+    return json;
+}
+
+std::vector<core::Error> decodeErrors(const nlohmann::json& json) {
+    std::vector<core::Error> errors;
+    if (!json.is_array()) {
+        return errors;
+    }
+    for (const auto& errorJson : json) {
+        errors.push_back(core::Error{errorJson.value("message", ""),
+                                     errorJson.value("location", ""),
+                                     static_cast<core::ErrorSeverity>(errorJson.value("severity", 0)),
+                                     static_cast<core::ErrorCategory>(errorJson.value("category", 0))});
+    }
+    return errors;
+}
+} // namespace
+
+ScanCache::ScanCache(std::string directory, const support::IFileSystem& fileSystem)
+    : directory_(std::move(directory)), fileSystem_(fileSystem) {}
+
+std::optional<TranslationUnitResult> ScanCache::lookup(const std::string& sourcePath,
+                                                       std::uint64_t commandFingerprint) const {
+    // A malformed entry (wrong member types, truncated file) is a miss
+    try {
+        return decodeEntry(sourcePath, commandFingerprint);
+    } catch (const nlohmann::json::exception&) {
+        return std::nullopt;
+    }
+}
+
+std::optional<TranslationUnitResult> ScanCache::decodeEntry(const std::string& sourcePath,
+                                                            std::uint64_t commandFingerprint) const {
+    auto entry = fileSystem_.readJsonFile(entryPath(sourcePath));
+    if (!entry || !entry->is_object()) {
+        return std::nullopt;
+    }
+
+    if (entry->value("version", 0) != kCacheFormatVersion ||
+        entry->value("tool", "") != kBuildId ||
+        entry->value("source", "") != sourcePath ||
+        entry->value("command", "") != support::toHex(commandFingerprint)) {
+        return std::nullopt;
+    }
+
+    TranslationUnitResult result;
+    result.sourcePath = sourcePath;
+
+    const auto dependencies = entry->find("dependencies");
+    if (dependencies == entry->end() || !dependencies->is_array()) {
+        return std::nullopt;
+    }
+    for (const auto& dependency : *dependencies) {
+        auto path = dependency.value("path", "");
+        auto current = contentHash(path);
+        const auto& recorded = dependency["hash"];
+        const bool unchanged = recorded.is_null() ? !current.has_value()
+                                                  : current && recorded == support::toHex(*current);
+        if (!unchanged) {
+            return std::nullopt;
+        }
+        result.dependencies.push_back(std::move(path));
+    }
+
+    auto components = serialization::decodeComponents(entry->value("components", nlohmann::json()));
+    if (!components) {
+        return std::nullopt;
+    }
+    result.components = std::move(*components);
+    result.errors = decodeErrors(entry->value("errors", nlohmann::json()));
+    return result;
+}
+
+bool ScanCache::store(const TranslationUnitResult& result, std::uint64_t commandFingerprint) const {
+    // Serialization throws on text that is not valid UTF-8, writing on an
+    // unusable cache directory
+    try {
+        return storeEntry(result, commandFingerprint);
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
+bool ScanCache::storeEntry(const TranslationUnitResult& result, std::uint64_t commandFingerprint) const {
+    nlohmann::json dependencies = nlohmann::json::array();
+    for (const auto& path : result.dependencies) {
+        auto hash = contentHash(path);
+        dependencies.push_back({{"path", path},
+                                {"hash", hash ? nlohmann::json(support::toHex(*hash)) : nlohmann::json()}});
+    }
+
+    nlohmann::json entry;
+    entry["version"] = kCacheFormatVersion;
+    entry["tool"] = std::string(kBuildId);
+    entry["source"] = result.sourcePath;
+    entry["command"] = support::toHex(commandFingerprint);
+    entry["dependencies"] = std::move(dependencies);
+    entry["components"] = serialization::encodeComponents(result.components);
+    entry["errors"] = encodeErrors(result.errors);
+
+    return fileSystem_.writeTextFile(entryPath(result.sourcePath), entry.dump()) != support::WriteStatus::Failed;
+}
+
+std::string ScanCache::entryPath(const std::string& sourcePath) const {
+    std::filesystem::path path(directory_);
+    path /= support::toHex(support::hashContent(sourcePath)) + ".json";
+    return path.string();
+}
+
+std::optional<std::uint64_t> ScanCache::contentHash(const std::string& path) const {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (auto it = hashes_.find(path); it != hashes_.end()) {
+            return it->second;
+        }
+    }
+
+    std::optional<std::uint64_t> hash;
+    if (auto contents = fileSystem_.readTextFile(path)) {
+        hash = support::hashContent(*contents);
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    hashes_.emplace(path, hash);
+    return hash;
+}
+
+} // namespace dsannotation::tooling
@@ -0,0 +1,170 @@
+#include "dsannotation/tooling/ScanExecutor.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <thread>
+
+#include "clang/Basic/Diagnostic.h"
+#include "clang/Tooling/Tooling.h"
+#include "llvm/Support/VirtualFileSystem.h"
+
+#include "dsannotation/support/ContentHash.h"
+#include "dsannotation/tooling/AnnotationPrefilter.h"
+#include "dsannotation/tooling/ComponentAction.h"
+#include "dsannotation/tooling/FragmentStore.h"
+#include "dsannotation/tooling/ScanCache.h"
+#include "dsannotation/tooling/ScanProfile.h"
+
+namespace dsannotation::tooling {
+
+namespace {
+// Compile commands plus the settings that decide which classes are
+// reported, so cached results are not reused across different profiles or
+// filters.
+std::uint64_t commandFingerprint(const std::vector<clang::tooling::CompileCommand>& commands,
+                                 const config::ParserConfig& config) {
+    support::ContentHasher hasher;
+    hasher.update(static_cast<std::uint64_t>(config.scanProfile));
+    hasher.update(static_cast<std::uint64_t>(config.discoveryMode));
+    hasher.update(static_cast<std::uint64_t>(config.skipSystemHeaders));
+    for (const auto* prefixes : {&config.includePathPrefixes, &config.excludePathPrefixes}) {
+        hasher.update(static_cast<std::uint64_t>(prefixes->size()));
+        for (const auto& prefix : *prefixes) {
+            hasher.update(prefix).update(std::string_view("\0", 1));
+        }
+    }
+    hasher.update(static_cast<std::uint64_t>(commands.size()));
+    for (const auto& command : commands) {
+        hasher.update(command.Directory).update(std::string_view("\0", 1));
+        hasher.update(command.Filename).update(std::string_view("\0", 1));
+        hasher.update(static_cast<std::uint64_t>(command.CommandLine.size()));
+        for (const auto& argument : command.CommandLine) {
+            hasher.update(argument).update(std::string_view("\0", 1));
+        }
+    }
+    return hasher.digest();
+}
+} // namespace
+
+ScanExecutor::ScanExecutor(const clang::tooling::CompilationDatabase& compilations,
+                           const ScanSession& session,
+                           unsigned jobs)
+    : compilations_(compilations), session_(session), jobs_(std::max(1u, jobs)) {}
+
+int ScanExecutor::run(const std::vector<std::string>& sourcePaths, ScanResults& results) const {
+    std::atomic<std::size_t> nextIndex{0};
+    std::atomic<int> status{0};
+
+    auto worker = [&]() {
+        for (std::size_t index = nextIndex++; index < sourcePaths.size(); index = nextIndex++) {
+            auto& result = results.slot(index);
+            int toolStatus = 0;
+            // An exception escaping a worker thread would terminate the
+            // process; it fails this translation unit instead.
+            try {
+                toolStatus = scanTranslationUnit(sourcePaths[index], result, results.statistics());
+            } catch (const std::exception& ex) {
+                result.errors.push_back(core::Error{"Failed to scan " + sourcePaths[index] + ": " + ex.what(),
+                                                    std::string{},
+                                                    core::ErrorSeverity::Error,
+                                                    core::ErrorCategory::General});
+                toolStatus = 1;
+            }
+            if (toolStatus != 0) {
+                int expected = 0;
+                status.compare_exchange_strong(expected, toolStatus);
+            }
+        }
+    };
+
+    const auto threadCount = std::min<std::size_t>(jobs_, sourcePaths.size());
+    if (threadCount <= 1) {
+        worker();
+        return status.load();
+    }
+
+    std::vector<std::thread> threads;
+    threads.reserve(threadCount);
+    for (std::size_t i = 0; i < threadCount; ++i) {
+        threads.emplace_back(worker);
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    return status.load();
+}
+
+int ScanExecutor::scanTranslationUnit(const std::string& sourcePath,
+                                      TranslationUnitResult& result,
+                                      ScanStatistics& statistics) const {
+    const auto commands = compilations_.getCompileCommands(clang::tooling::getAbsolutePath(sourcePath));
+    const auto fingerprint = commandFingerprint(commands, session_.config);
+
+    const int status = collectResult(sourcePath, commands, fingerprint, result, statistics);
+    if (session_.fragments) {
+        // Skipped translation units too, so a fragment of an earlier run
+        // does not outlive its components
+        if (!session_.fragments->store(result)) {
+            result.errors.push_back(core::Error{"Failed to write fragment " +
+                                                    session_.fragments->fragmentPath(sourcePath) + " for " + sourcePath,
+                                                std::string{},
+                                                core::ErrorSeverity::Error,
+                                                core::ErrorCategory::IO});
+            return status != 0 ? status : 1;
+        }
+    }
+    return status;
+}
+
+int ScanExecutor::collectResult(const std::string& sourcePath,
+                                const std::vector<clang::tooling::CompileCommand>& commands,
+                                std::uint64_t fingerprint,
+                                TranslationUnitResult& result,
+                                ScanStatistics& statistics) const {
+    if (session_.prefilter && !session_.prefilter->mayContainComponents(commands)) {
+        ++statistics.translationUnitsSkipped;
+        return 0;
+    }
+
+    const auto* cache = session_.cache;
+    if (cache) {
+        if (auto cached = cache->lookup(sourcePath, fingerprint)) {
+            cached->ordinal = result.ordinal;
+            result = std::move(*cached);
+            ++statistics.cacheHits;
+            return 0;
+        }
+        ++statistics.cacheMisses;
+    }
+
+    // The physical file system keeps its own working directory, so
+    // concurrent tools do not chdir() the whole process.
+    clang::tooling::ClangTool tool(compilations_,
+                                   {sourcePath},
+                                   std::make_shared<clang::PCHContainerOperations>(),
+                                   llvm::vfs::createPhysicalFileSystem());
+    clang::IgnoringDiagConsumer ignoringDiagnostics;
+    if (session_.config.scanProfile == config::ScanProfile::Declarations) {
+        tool.appendArgumentsAdjuster(getDeclarationScanAdjuster());
+        tool.setDiagnosticConsumer(&ignoringDiagnostics);
+    }
+
+    ComponentActionFactory factory(session_, result);
+    const int toolStatus = tool.run(&factory);
+    ++statistics.translationUnitsParsed;
+    statistics.interfaceNameLookups += result.interfaceNameLookups;
+    statistics.interfaceNameHits += result.interfaceNameHits;
+
+    if (cache && toolStatus == 0 && !cache->store(result, fingerprint)) {
+        result.errors.push_back(core::Error{"Failed to write scan cache entry for " + sourcePath,
+                                            std::string{},
+                                            core::ErrorSeverity::Warning,
+                                            core::ErrorCategory::IO});
+    }
+
+    return toolStatus;
+}
+
+} // namespace dsannotation::tooling
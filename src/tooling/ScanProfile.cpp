@@ -0,0 +1,176 @@
+#include "dsannotation/tooling/ScanProfile.h"
+
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <string>
+
+#include "llvm/ADT/StringRef.h"
+
+namespace dsannotation::tooling {
+
+namespace {
+bool isWarningFlag(llvm::StringRef argument) {
+    if (argument == "-w" || argument == "-pedantic" || argument == "-pedantic-errors") {
+        return true;
+    }
+    // -Wp, forwards preprocessor options (e.g. macro definitions) and must stay.
+    return argument.startswith("-W") && !argument.startswith("-Wp,");
+}
+
+bool isOptimizationFlag(llvm::StringRef argument) {
+    return argument.startswith("-O");
+}
+
+bool isDebugInfoFlag(llvm::StringRef argument) {
+    if (argument == "-gcc-toolchain" || argument.startswith("-gcc-toolchain=")) {
+        return false;
+    }
+    return argument.startswith("-g");
+}
+
+bool isCodegenFlag(llvm::StringRef argument) {
+    static constexpr llvm::StringLiteral kPrefixes[] = {
+        "-fPIC", "-fpic", "-fPIE", "-fpie", "-fno-pic", "-fno-pie",
+        "-flto", "-fno-lto", "-fsanitize", "-fno-sanitize",
+        "-fprofile", "-fno-profile", "-fcoverage", "-fno-coverage",
+        "-ffunction-sections", "-fdata-sections",
+        "-fstack-protector", "-fno-stack-protector",
+        "-fomit-frame-pointer", "-fno-omit-frame-pointer",
+        "-fdebug-prefix-map", "-ffile-prefix-map", "-fvisibility",
+        "-fcolor-diagnostics", "-fno-color-diagnostics", "-fdiagnostics-",
+    };
+    for (const auto prefix : kPrefixes) {
+        if (argument.startswith(prefix)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// cl spellings, given without their '/' or '-' prefix
+bool isMsvcStrippable(llvm::StringRef option) {
+    // /W4, /WX, /Wall, /w, /wd4996, /we4996, /wo4996, /w14996
+    if (option.startswith("W") || option == "w") {
+        return true;
+    }
+    if (option.size() > 2 && option[0] == 'w' && llvm::StringRef("deo1234").find(option[1]) != llvm::StringRef::npos &&
+        std::isdigit(static_cast<unsigned char>(option[2]))) {
+        return true;
+    }
+    // /O2, /Od, /Ox, /Ob2, /Oi, /Oy-
+    if (option.startswith("O")) {
+        return true;
+    }
+    static constexpr llvm::StringLiteral kOptions[] = {
+        "Zi", "Z7", "ZI", "GL", "GL-", "Gy", "Gy-", "GS", "GS-", "Gw", "Gw-",
+    };
+    for (const auto candidate : kOptions) {
+        if (option == candidate) {
+            return true;
+        }
+    }
+    return option.startswith("RTC") || option.startswith("guard:");
+}
+
+bool isStrippable(llvm::StringRef argument, bool msvcStyle) {
+    if (msvcStyle && (argument.startswith("/") || argument.startswith("-")) &&
+        !argument.startswith("-Wp,") && isMsvcStrippable(argument.drop_front())) {
+        return true;
+    }
+    return isWarningFlag(argument) || isOptimizationFlag(argument) ||
+           isDebugInfoFlag(argument) || isCodegenFlag(argument);
+}
+
+// Pass their value on to a tool; the pair is kept or dropped as a whole.
+bool isForwardingOption(llvm::StringRef argument) {
+    return argument == "-Xclang" || argument == "-Xpreprocessor" || argument == "-mllvm" ||
+           argument == "-Xassembler" || argument == "-Xlinker";
+}
+
+// Take their value as the next argument, which is never a flag of its own.
+bool takesSeparateValue(llvm::StringRef argument, bool msvcStyle) {
+    static constexpr llvm::StringLiteral kOptions[] = {
+        "-o", "-x", "-I", "-D", "-U", "-F", "-include", "-imacros", "-isystem",
+        "-iquote", "-idirafter", "-isysroot", "-iframework", "-imsvc", "-iprefix",
+        "-iwithprefix", "-MF", "-MT", "-MQ", "-target", "-arch", "-gcc-toolchain",
+    };
+    static constexpr llvm::StringLiteral kMsvcOptions[] = {
+        "/I", "/D", "/U", "/FI", "/imsvc", "/external:I", "/winsysroot", "/vctoolsdir",
+        "-FI", "-external:I", "-winsysroot", "-vctoolsdir",
+    };
+    for (const auto option : kOptions) {
+        if (argument == option) {
+            return true;
+        }
+    }
+    if (msvcStyle) {
+        for (const auto option : kMsvcOptions) {
+            if (argument == option) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+} // namespace
+
+bool isMsvcDriver(std::string_view driver) {
+    auto name = std::filesystem::path(driver).stem().string();
+    std::transform(name.begin(), name.end(), name.begin(), [](unsigned char c) {
+        return static_cast<char>(std::tolower(c));
+    });
+    return name == "cl" || name == "clang-cl";
+}
+
+clang::tooling::CommandLineArguments adjustForDeclarationScan(const clang::tooling::CommandLineArguments& arguments,
+                                                              std::string_view filename) {
+    clang::tooling::CommandLineArguments adjusted;
+    adjusted.reserve(arguments.size() + 2);
+    const bool msvcStyle = !arguments.empty() && isMsvcDriver(arguments.front());
+    auto separator = arguments.end();
+    for (std::size_t i = 0; i < arguments.size(); ++i) {
+        llvm::StringRef argument = arguments[i];
+        if (i > 0 && argument == "--") {
+            separator = arguments.begin() + i;
+            break;
+        }
+        // The driver and the file itself, which a cl-style driver could
+        // mistake for an option such as /Opt/src/main.cpp
+        if (i == 0 || argument == llvm::StringRef(filename.data(), filename.size())) {
+            adjusted.push_back(arguments[i]);
+            continue;
+        }
+        if (i + 1 < arguments.size() && isForwardingOption(argument)) {
+            if (!isStrippable(arguments[i + 1], msvcStyle)) {
+                adjusted.push_back(arguments[i]);
+                adjusted.push_back(arguments[i + 1]);
+            }
+            ++i;
+            continue;
+        }
+        if (i + 1 < arguments.size() && takesSeparateValue(argument, msvcStyle)) {
+            adjusted.push_back(arguments[i]);
+            adjusted.push_back(arguments[++i]);
+            continue;
+        }
+        if (isStrippable(argument, msvcStyle)) {
+            continue;
+        }
+        adjusted.push_back(arguments[i]);
+    }
+
+    // Inserted before "--", which ends the options
+    adjusted.push_back("-fsyntax-only");
+    adjusted.push_back("-w");
+    adjusted.insert(adjusted.end(), separator, arguments.end());
+    return adjusted;
+}
+
+clang::tooling::ArgumentsAdjuster getDeclarationScanAdjuster() {
+    return [](const clang::tooling::CommandLineArguments& arguments, llvm::StringRef filename) {
+        return adjustForDeclarationScan(arguments, std::string_view(filename.data(), filename.size()));
+    };
+}
+
+} // namespace dsannotation::tooling
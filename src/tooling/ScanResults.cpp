@@ -0,0 +1,118 @@
+#include "dsannotation/tooling/ScanResults.h"
+
+#include <algorithm>
+#include <sstream>
+#include <tuple>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+namespace dsannotation::tooling {
+
+namespace {
+bool sameReference(const core::Reference& lhs, const core::Reference& rhs) {
+    return lhs.name() == rhs.name() && lhs.interface() == rhs.interface() &&
+           lhs.properties() == rhs.properties();
+}
+
+bool sameDefinition(const core::Component& lhs, const core::Component& rhs) {
+    return lhs.className() == rhs.className() && lhs.interfaces() == rhs.interfaces() &&
+           lhs.attributes() == rhs.attributes() && lhs.properties() == rhs.properties() &&
+           std::equal(lhs.references().begin(), lhs.references().end(),
+                      rhs.references().begin(), rhs.references().end(),
+                      sameReference);
+}
+} // namespace
+
+std::string ScanStatistics::summary() const {
+    std::ostringstream builder;
+    builder << "Translation units parsed: " << translationUnitsParsed.load() << '\n';
+    if (const auto skipped = translationUnitsSkipped.load(); skipped > 0) {
+        builder << "Translation units skipped by prefilter (no @component): " << skipped << '\n';
+    }
+    const auto hits = cacheHits.load();
+    const auto misses = cacheMisses.load();
+    if (hits + misses > 0) {
+        builder << "Scan cache: " << hits << " hits, " << misses << " misses\n";
+    }
+    if (const auto lookups = interfaceNameLookups.load(); lookups > 0) {
+        const auto nameHits = interfaceNameHits.load();
+        builder << "Interface name cache: " << nameHits << " hits / " << lookups << " lookups ("
+                << (nameHits * 100 / lookups) << "%)\n";
+    }
+    return builder.str();
+}
+
+ScanResults::ScanResults(const std::vector<std::string>& sourcePaths,
+                         const std::vector<std::size_t>& ordinals) {
+    slots_.reserve(sourcePaths.size());
+    for (std::size_t i = 0; i < sourcePaths.size(); ++i) {
+        TranslationUnitResult slot;
+        slot.sourcePath = sourcePaths[i];
+        slot.ordinal = i < ordinals.size() ? ordinals[i] : i;
+        slots_.push_back(std::move(slot));
+    }
+}
+
+std::vector<const TranslationUnitResult*> ScanResults::inSourceOrder() const {
+    std::vector<const TranslationUnitResult*> units;
+    units.reserve(slots_.size());
+    for (const auto& unit : slots_) {
+        units.push_back(&unit);
+    }
+    std::stable_sort(units.begin(), units.end(), [](const auto* lhs, const auto* rhs) {
+        return std::tie(lhs->ordinal, lhs->sourcePath) < std::tie(rhs->ordinal, rhs->sourcePath);
+    });
+    return units;
+}
+
+core::ComponentList ScanResults::components() const {
+    core::ComponentList components;
+    std::unordered_set<std::string> seen;
+    for (const auto* unit : inSourceOrder()) {
+        for (const auto& component : unit->components) {
+            if (seen.insert(component.className()).second) {
+                components.push_back(component);
+            }
+        }
+    }
+    return components;
+}
+
+std::vector<core::Error> ScanResults::errors() const {
+    std::vector<core::Error> errors;
+    std::unordered_set<std::string> seen;
+    // implementation class -> kept definition and the source it came from
+    std::unordered_map<std::string, std::pair<const core::Component*, const std::string*>> kept;
+    std::vector<core::Error> conflicts;
+
+    for (const auto* unit : inSourceOrder()) {
+        for (const auto& error : unit->errors) {
+            auto key = error.message + '\0' + error.location + '\0' +
+                       std::to_string(static_cast<int>(error.severity)) + '\0' +
+                       std::to_string(static_cast<int>(error.category));
+            if (seen.insert(std::move(key)).second) {
+                errors.push_back(error);
+            }
+        }
+
+        for (const auto& component : unit->components) {
+            auto [it, inserted] = kept.emplace(component.className(),
+                                               std::make_pair(&component, &unit->sourcePath));
+            if (!inserted && !sameDefinition(*it->second.first, component)) {
+                conflicts.push_back(core::Error{"Conflicting definitions of component '" + component.className() +
+                                                    "': the definition seen by " + unit->sourcePath +
+                                                    " differs from the one seen by " + *it->second.second +
+                                                    ", which is kept",
+                                                std::string{},
+                                                core::ErrorSeverity::Error,
+                                                core::ErrorCategory::Component});
+            }
+        }
+    }
+
+    errors.insert(errors.end(), conflicts.begin(), conflicts.end());
+    return errors;
+}
+
+} // namespace dsannotation::tooling
@@ -0,0 +1,67 @@
+#include "dsannotation/tooling/ShardPartition.h"
+
+#include <charconv>
+#include <filesystem>
+
+#include "dsannotation/support/ContentHash.h"
+
+namespace dsannotation::tooling {
+
+namespace {
+std::optional<unsigned> parseUnsigned(std::string_view text) {
+    unsigned value = 0;
+    const auto* end = text.data() + text.size();
+    auto [ptr, error] = std::from_chars(text.data(), end, value);
+    if (text.empty() || error != std::errc() || ptr != end) {
+        return std::nullopt;
+    }
+    return value;
+}
+} // namespace
+
+std::optional<config::ShardSpec> parseShardSpec(std::string_view text) {
+    const auto slash = text.find('/');
+    if (slash == std::string_view::npos) {
+        return std::nullopt;
+    }
+    const auto index = parseUnsigned(text.substr(0, slash));
+    const auto count = parseUnsigned(text.substr(slash + 1));
+    if (!index || !count || *count == 0 || *index >= *count) {
+        return std::nullopt;
+    }
+    return config::ShardSpec{*index, *count};
+}
+
+std::string partitionKey(const std::string& sourcePath, const std::string& rootDirectory) {
+    auto root = std::filesystem::path(rootDirectory).lexically_normal();
+    if (!root.has_filename() && root.has_relative_path()) {
+        root = root.parent_path();
+    }
+    const auto source = (root / sourcePath).lexically_normal();
+    if (root.empty()) {
+        return source.generic_string();
+    }
+    const auto relative = source.lexically_relative(root);
+    return relative.empty() ? source.generic_string() : relative.generic_string();
+}
+
+std::vector<std::size_t> selectShard(const std::vector<std::string>& partitionKeys, const config::ShardSpec& shard) {
+    std::vector<std::size_t> selected;
+    for (std::size_t i = 0; i < partitionKeys.size(); ++i) {
+        if (support::hashContent(partitionKeys[i]) % shard.count == shard.index) {
+            selected.push_back(i);
+        }
+    }
+    return selected;
+}
+
+std::uint64_t runIdentity(const std::vector<std::string>& partitionKeys) {
+    support::ContentHasher hasher;
+    hasher.update(static_cast<std::uint64_t>(partitionKeys.size()));
+    for (const auto& key : partitionKeys) {
+        hasher.update(static_cast<std::uint64_t>(key.size())).update(key);
+    }
+    return hasher.digest();
+}
+
+} // namespace dsannotation::tooling
@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "dsannotation/tooling/AnnotationPrefilter.h"
+
+namespace fs = std::filesystem;
+using clang::tooling::CompileCommand;
+using dsannotation::tooling::AnnotationPrefilter;
+
+class AnnotationPrefilterTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        directory_ = fs::temp_directory_path() /
+                     ("dsannotation_prefilter_" + std::to_string(::testing::UnitTest::GetInstance()->random_seed()) +
+                      "_" + ::testing::UnitTest::GetInstance()->current_test_info()->name());
+        fs::remove_all(directory_);
+    }
+
+    void TearDown() override { fs::remove_all(directory_); }
+
+    std::string path(const std::string& name) const { return (directory_ / name).string(); }
+
+    void write(const std::string& name, const std::string& contents) const {
+        fs::create_directories((directory_ / name).parent_path());
+        std::ofstream(directory_ / name, std::ios::binary) << contents;
+    }
+
+    // A command compiling `source` in the test directory with `arguments`
+    // between the driver and the file name.
+    std::vector<CompileCommand> command(const std::string& source, const std::vector<std::string>& arguments = {}) const {
+        CompileCommand compileCommand;
+        compileCommand.Directory = directory_.string();
+        compileCommand.Filename = source;
+        compileCommand.CommandLine.push_back("clang++");
+        compileCommand.CommandLine.insert(compileCommand.CommandLine.end(), arguments.begin(), arguments.end());
+        compileCommand.CommandLine.push_back(source);
+        return {compileCommand};
+    }
+
+    fs::path directory_;
+};
+
+TEST_F(AnnotationPrefilterTest, FindsMarkerInNestedQuotedHeader) {
+    write("main.cpp", "#include \"a.h\"\nint main() {}\n");
+    write("a.h", "#pragma once\n  #  include \"sub/b.h\"\n");
+    write("sub/b.h", "/** @component */\nclass Logger {};\n");
+    write("clean.cpp", "#include \"sub/c.h\"\n");
+    write("sub/c.h", "#include <vector>\n");
+
+    AnnotationPrefilter prefilter;
+    EXPECT_TRUE(prefilter.mayContainComponents(command("main.cpp")));
+    EXPECT_FALSE(prefilter.mayContainComponents(command("clean.cpp")));
+}
+
+TEST_F(AnnotationPrefilterTest, UnresolvedQuotedIncludeMayContain) {
+    write("main.cpp", "#include \"generated/config.h\"\n");
+    write("computed.cpp", "#include CONFIG_HEADER\n");
+
+    AnnotationPrefilter prefilter;
+    EXPECT_TRUE(prefilter.mayContainComponents(command("main.cpp")));
+    EXPECT_TRUE(prefilter.mayContainComponents(command("computed.cpp")));
+    EXPECT_TRUE(prefilter.mayContainComponents(std::vector<CompileCommand>{}));
+}
+
+TEST_F(AnnotationPrefilterTest, ResolvesQuoteSystemAndForcedIncludes) {
+    write("main.cpp", "#include \"quoted.h\"\n");
+    write("quote/quoted.h", "// @component\n");
+    write("system.cpp", "#include <lib.h>\n");
+    write("sys/lib.h", "// @component\n");
+    write("plain.cpp", "int x;\n");
+    write("forced/prefix.h", "// @component\n");
+
+    AnnotationPrefilter prefilter;
+    EXPECT_TRUE(prefilter.mayContainComponents(command("main.cpp", {"-iquote", "quote"})));
+    EXPECT_TRUE(prefilter.mayContainComponents(command("main.cpp", {"-iquotequote"})));
+    EXPECT_FALSE(prefilter.mayContainComponents(command("system.cpp", {"-isystem", "sys"})));
+    EXPECT_TRUE(prefilter.mayContainComponents(command("system.cpp", {"-I", "sys"})));
+    EXPECT_FALSE(prefilter.mayContainComponents(command("plain.cpp")));
+    EXPECT_TRUE(prefilter.mayContainComponents(command("plain.cpp", {"-include", "forced/prefix.h"})));
+
+    AnnotationPrefilter followingSystemHeaders(true);
+    EXPECT_TRUE(followingSystemHeaders.mayContainComponents(command("system.cpp", {"-isystem", "sys"})));
+    EXPECT_TRUE(followingSystemHeaders.mayContainComponents(command("system.cpp")));
+}
+
+TEST_F(AnnotationPrefilterTest, IncludeNextMayContain) {
+    write("main.cpp", "#include <wrap.h>\n");
+    write("first/wrap.h", "#pragma once\n#include_next <wrap.h>\n");
+    write("second/wrap.h", "// @component\n");
+
+    AnnotationPrefilter prefilter;
+    EXPECT_TRUE(prefilter.mayContainComponents(command("main.cpp", {"-Ifirst", "-Isecond"})));
+}
+
+TEST_F(AnnotationPrefilterTest, CleanClosuresAreKeptPerSearchPath) {
+    write("main.cpp", "#include <x.h>\n");
+    write("clean/x.h", "int x;\n");
+    write("marked/x.h", "// @component\n");
+
+    AnnotationPrefilter prefilter;
+    EXPECT_FALSE(prefilter.mayContainComponents(command("main.cpp", {"-Iclean"})));
+    EXPECT_TRUE(prefilter.mayContainComponents(command("main.cpp", {"-Imarked"})));
+    EXPECT_FALSE(prefilter.mayContainComponents(command("main.cpp", {"-Iclean"})));
+}
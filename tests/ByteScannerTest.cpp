@@ -0,0 +1,75 @@
+#include <gtest/gtest.h>
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "dsannotation/support/ByteScanner.h"
+
+using dsannotation::support::ScanKernel;
+namespace support = dsannotation::support;
+
+class ByteScannerTest : public ::testing::TestWithParam<ScanKernel> {
+protected:
+    void SetUp() override {
+        if (!support::isScanKernelSupported(GetParam())) {
+            GTEST_SKIP() << "kernel not supported on this CPU";
+        }
+    }
+
+    static std::string randomText(std::mt19937& rng, std::size_t size, unsigned structuralPercent) {
+        std::string text(size, 'a');
+        for (auto& c : text) {
+            c = static_cast<char>(rng() % 256);
+            // Bias towards plain text so that long skips are exercised
+            if (support::isStructuralByte(c) && rng() % 100 >= structuralPercent) {
+                c = 'x';
+            }
+        }
+        return text;
+    }
+};
+
+TEST_P(ByteScannerTest, ClassifiesEveryByteValueLikeScalar) {
+    std::vector<char> block(support::kScanBlockSize);
+    for (unsigned first = 0; first < 256; first += support::kScanBlockSize) {
+        for (std::size_t i = 0; i < block.size(); ++i) {
+            block[i] = static_cast<char>((first + i) % 256);
+        }
+        EXPECT_EQ(support::classifyBlock(block.data(), GetParam()),
+                  support::classifyBlock(block.data(), ScanKernel::Scalar))
+            << "block starting at byte " << first;
+    }
+}
+
+TEST_P(ByteScannerTest, ScalarMaskMatchesByteClassification) {
+    const std::string block = "a{b}c[d]e(f)g\"h'i\\j@k\x01\x7f\n\t\r\x80\xff zzzzzzz";
+    ASSERT_GE(block.size(), support::kScanBlockSize);
+    const auto mask = support::classifyBlock(block.data(), GetParam());
+    for (std::size_t i = 0; i < support::kScanBlockSize; ++i) {
+        EXPECT_EQ(((mask >> i) & 1u) != 0, support::isStructuralByte(block[i])) << "offset " << i;
+    }
+}
+
+TEST_P(ByteScannerTest, FindsSameStructuralBytesAsScalar) {
+    std::mt19937 rng(1234);
+    for (int round = 0; round < 200; ++round) {
+        const auto text = randomText(rng, rng() % 300, round % 10);
+        for (std::size_t from = 0; from <= text.size(); from += 1 + rng() % 7) {
+            ASSERT_EQ(support::findStructuralByte(text, from, GetParam()),
+                      support::findStructuralByte(text, from, ScanKernel::Scalar))
+                << "round " << round << " from " << from;
+        }
+    }
+}
+
+TEST_P(ByteScannerTest, ReturnsSizeWithoutStructuralBytes) {
+    const std::string text(1000, 'z');
+    EXPECT_EQ(support::findStructuralByte(text, 0, GetParam()), text.size());
+    EXPECT_EQ(support::findStructuralByte(text, 2000, GetParam()), text.size());
+    EXPECT_EQ(support::findStructuralByte(text + "@", 0, GetParam()), text.size());
+}
+
+INSTANTIATE_TEST_SUITE_P(Kernels,
+                         ByteScannerTest,
+                         ::testing::Values(ScanKernel::Scalar, ScanKernel::SSE2, ScanKernel::AVX2));
@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+#include "dsannotation/support/CachingFileSystem.h"
+#include "dsannotation/support/LocalFileSystem.h"
+
+namespace fs = std::filesystem;
+using namespace dsannotation::support;
+
+namespace {
+
+class CountingFileSystem final : public IFileSystem {
+public:
+    bool exists(const std::string& path) const override { return inner_.exists(path); }
+    std::optional<std::string> readTextFile(const std::string& path) const override {
+        return inner_.readTextFile(path);
+    }
+    std::optional<nlohmann::json> readJsonFile(const std::string& path) const override {
+        ++jsonReads;
+        return inner_.readJsonFile(path);
+    }
+    WriteStatus writeTextFile(const std::string& path, const std::string& contents) const override {
+        return inner_.writeTextFile(path, contents);
+    }
+
+    mutable std::atomic<int> jsonReads{0};
+
+private:
+    LocalFileSystem inner_;
+};
+
+} // namespace
+
+class CachingFileSystemTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        directory_ = fs::temp_directory_path() /
+                     ("dsannotation_caching_fs_" + std::to_string(::testing::UnitTest::GetInstance()->random_seed()) +
+                      "_" + ::testing::UnitTest::GetInstance()->current_test_info()->name());
+        fs::create_directories(directory_);
+    }
+
+    void TearDown() override { fs::remove_all(directory_); }
+
+    std::string write(const std::string& name, const std::string& contents) {
+        const auto path = (directory_ / name).string();
+        std::ofstream(path) << contents;
+        return path;
+    }
+
+    fs::path directory_;
+    CountingFileSystem inner_;
+};
+
+TEST_F(CachingFileSystemTest, ParsesEachFileOnce) {
+    const auto path = write("props.json", R"({"level": 3})");
+    CachingFileSystem cache(inner_);
+
+    for (int i = 0; i < 5; ++i) {
+        auto json = cache.readJsonFile(path);
+        ASSERT_TRUE(json.has_value());
+        EXPECT_EQ((*json)["level"], 3);
+    }
+
+    EXPECT_EQ(inner_.jsonReads.load(), 1);
+    EXPECT_EQ(cache.misses(), 1u);
+    EXPECT_EQ(cache.hits(), 4u);
+}
+
+TEST_F(CachingFileSystemTest, KeysByNormalizedPath) {
+    fs::create_directories(directory_ / "sub");
+    const auto path = write("props.json", R"({"a": 1})");
+    CachingFileSystem cache(inner_);
+
+    cache.readJsonFile(path);
+    cache.readJsonFile((directory_ / "sub" / ".." / "props.json").string());
+
+    EXPECT_EQ(inner_.jsonReads.load(), 1);
+}
+
+TEST_F(CachingFileSystemTest, RereadsModifiedFiles) {
+    const auto path = write("props.json", R"({"a": 1})");
+    CachingFileSystem cache(inner_);
+    cache.readJsonFile(path);
+
+    write("props.json", R"({"a": 22})");
+    fs::last_write_time(path, fs::last_write_time(path) + std::chrono::seconds(2));
+
+    auto json = cache.readJsonFile(path);
+    ASSERT_TRUE(json.has_value());
+    EXPECT_EQ((*json)["a"], 22);
+    EXPECT_EQ(inner_.jsonReads.load(), 2);
+}
+
+TEST_F(CachingFileSystemTest, CachesInvalidFilesAndForwardsMissingOnes) {
+    const auto invalid = write("broken.json", "{ not json");
+    const auto missing = (directory_ / "missing.json").string();
+    CachingFileSystem cache(inner_);
+
+    EXPECT_FALSE(cache.readJsonFile(invalid).has_value());
+    EXPECT_FALSE(cache.readJsonFile(invalid).has_value());
+    EXPECT_FALSE(cache.readJsonFile(missing).has_value());
+    EXPECT_FALSE(cache.readJsonFile(missing).has_value());
+
+    EXPECT_EQ(inner_.jsonReads.load(), 3);
+}
+
+TEST_F(CachingFileSystemTest, ConcurrentReadersParseOnce) {
+    const auto path = write("props.json", R"({"shared": true})");
+    CachingFileSystem cache(inner_);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; ++t) {
+        threads.emplace_back([&] {
+            for (int i = 0; i < 100; ++i) {
+                auto json = cache.readJsonFile(path);
+                ASSERT_TRUE(json.has_value());
+                EXPECT_EQ((*json)["shared"], true);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(inner_.jsonReads.load(), 1);
+    EXPECT_EQ(cache.hits() + cache.misses(), 800u);
+}
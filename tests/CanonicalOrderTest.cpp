@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <sstream>
+#include <string>
+
+#include "dsannotation/serialization/CanonicalOrder.h"
+#include "dsannotation/serialization/JsonManifestBuilder.h"
+#include "dsannotation/serialization/StreamingManifestSerializer.h"
+
+using dsannotation::core::Component;
+using dsannotation::core::ComponentList;
+using dsannotation::core::Reference;
+using dsannotation::serialization::JsonManifestBuilder;
+using dsannotation::serialization::StreamingManifestSerializer;
+using dsannotation::serialization::sortManifest;
+
+namespace {
+
+ComponentList sampleComponents() {
+    ComponentList components;
+    for (const char* name : {"app::Logger", "app::Clock", "app::Zeta", "app::Alpha"}) {
+        Component component(name);
+        component.addInterface("app::IService");
+        component.addReference(Reference("sink", "app::ISink"));
+        component.addReference(Reference("clock", "app::IClock"));
+        component.addReference(Reference("bus", "app::IBus"));
+        components.push_back(std::move(component));
+    }
+
+    Component renamed("app::Renamed");
+    renamed.setAttributes({{"implementation-class", "app::Beta"}});
+    Reference aliased("zz", "app::IAlias");
+    aliased.setProperties({{"name", "aa"}});
+    renamed.addReference(aliased);
+    renamed.addReference(Reference("mm", "app::IOther"));
+    components.push_back(std::move(renamed));
+    return components;
+}
+
+std::string canonicalBuilt(const ComponentList& components, int indentation) {
+    auto manifest = JsonManifestBuilder().buildManifest(components);
+    sortManifest(manifest);
+    return manifest.dump(indentation);
+}
+
+std::string canonicalStreamed(const ComponentList& components, int indentation) {
+    std::ostringstream output;
+    StreamingManifestSerializer(indentation, true).write(output, components);
+    return output.str();
+}
+
+} // namespace
+
+TEST(CanonicalOrderTest, SortsComponentsAndReferences) {
+    auto manifest = JsonManifestBuilder().buildManifest(sampleComponents());
+    sortManifest(manifest);
+
+    const auto& components = manifest["scr"]["components"];
+    ASSERT_EQ(5u, components.size());
+    EXPECT_EQ("app::Alpha", components[0]["implementation-class"]);
+    EXPECT_EQ("app::Beta", components[1]["implementation-class"]);
+    EXPECT_EQ("app::Clock", components[2]["implementation-class"]);
+    EXPECT_EQ("app::Logger", components[3]["implementation-class"]);
+    EXPECT_EQ("app::Zeta", components[4]["implementation-class"]);
+
+    EXPECT_EQ("bus", components[0]["references"][0]["name"]);
+    EXPECT_EQ("clock", components[0]["references"][1]["name"]);
+    EXPECT_EQ("sink", components[0]["references"][2]["name"]);
+    EXPECT_EQ("aa", components[1]["references"][0]["name"]);
+}
+
+TEST(CanonicalOrderTest, OutputIsIndependentOfInputOrder) {
+    auto components = sampleComponents();
+    const auto expected = canonicalBuilt(components, 4);
+
+    std::mt19937 random(7);
+    for (int round = 0; round < 10; ++round) {
+        std::shuffle(components.begin(), components.end(), random);
+        EXPECT_EQ(expected, canonicalBuilt(components, 4));
+        EXPECT_EQ(expected, canonicalStreamed(components, 4));
+    }
+}
+
+TEST(CanonicalOrderTest, StreamedMatchesSortedBuild) {
+    const auto components = sampleComponents();
+    for (int indentation : {-1, 0, 2, 4}) {
+        EXPECT_EQ(canonicalBuilt(components, indentation), canonicalStreamed(components, indentation))
+            << "indentation " << indentation;
+    }
+}
+
+TEST(CanonicalOrderTest, LeavesManifestsWithoutComponentsAlone) {
+    nlohmann::json manifest = {{"bundle", {{"name", "b"}}}};
+    const auto expected = manifest;
+    sortManifest(manifest);
+    EXPECT_EQ(expected, manifest);
+
+    nlohmann::json scalarComponents = {{"scr", {{"components", 3}}}};
+    sortManifest(scalarComponents);
+    EXPECT_EQ(3, scalarComponents["scr"]["components"]);
+}
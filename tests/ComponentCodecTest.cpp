@@ -0,0 +1,40 @@
+#include <gtest/gtest.h>
+
+#include "dsannotation/serialization/ComponentCodec.h"
+
+using dsannotation::core::Component;
+using dsannotation::core::Reference;
+
+TEST(ComponentCodecTest, RoundTripsComponent) {
+    Component component("app::Logger");
+    component.addInterface("app::ILogger");
+    component.setAttributes({{"immediate", true}});
+    component.setProperties({{"level", "debug"}});
+    Reference reference("IClock", "app::IClock");
+    reference.setProperties({{"cardinality", "0..1"}});
+    component.addReference(reference);
+
+    auto decoded = dsannotation::serialization::decodeComponent(
+        dsannotation::serialization::encodeComponent(component));
+
+    ASSERT_TRUE(decoded.has_value());
+    EXPECT_EQ(decoded->className(), "app::Logger");
+    EXPECT_EQ(decoded->interfaces(), std::vector<std::string>{"app::ILogger"});
+    EXPECT_EQ(decoded->attributes(), component.attributes());
+    EXPECT_EQ(decoded->properties(), component.properties());
+    ASSERT_EQ(decoded->references().size(), 1u);
+    EXPECT_EQ(decoded->references()[0].name(), "IClock");
+    EXPECT_EQ(decoded->references()[0].interface(), "app::IClock");
+    EXPECT_EQ(decoded->references()[0].properties(), reference.properties());
+}
+
+TEST(ComponentCodecTest, RejectsMalformedInput) {
+    EXPECT_FALSE(dsannotation::serialization::decodeComponent(nlohmann::json::array()).has_value());
+    EXPECT_FALSE(dsannotation::serialization::decodeComponent({{"interfaces", nlohmann::json::array()}}).has_value());
+    EXPECT_FALSE(dsannotation::serialization::decodeComponents({{{"class", 1}}}).has_value());
+
+    const nlohmann::json numericName = {{"class", "a::B"}, {"references", {{{"name", 1}, {"interface", "a::I"}}}}};
+    EXPECT_FALSE(dsannotation::serialization::decodeComponent(numericName).has_value());
+    const nlohmann::json nullInterface = {{"class", "a::B"}, {"references", {{{"name", "r"}, {"interface", nullptr}}}}};
+    EXPECT_FALSE(dsannotation::serialization::decodeComponent(nullInterface).has_value());
+}
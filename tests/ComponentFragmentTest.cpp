@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <string>
+
+#include "dsannotation/serialization/ComponentFragment.h"
+#include "dsannotation/support/LocalFileSystem.h"
+
+using dsannotation::core::Component;
+using dsannotation::core::Reference;
+using dsannotation::serialization::ComponentFragment;
+using dsannotation::serialization::decodeFragment;
+using dsannotation::serialization::encodeFragment;
+using dsannotation::serialization::readFragment;
+
+namespace {
+
+ComponentFragment sampleFragment() {
+    Component component("app::Logger");
+    component.addInterface("app::ILogger");
+    component.setAttributes({{"immediate", true}});
+    component.setProperties({{"banner", "line1\nline2\r\n"}, {"level", 3}});
+    Reference reference("IClock", "app::IClock");
+    reference.setProperties({{"cardinality", "0..1"}});
+    component.addReference(reference);
+
+    ComponentFragment fragment;
+    fragment.sourcePath = "src/logger.cpp";
+    fragment.sourceFingerprint = 0x0123456789abcdefULL;
+    fragment.ordinal = 42;
+    fragment.runIdentity = 0xfedcba9876543210ULL;
+    fragment.shardIndex = 2;
+    fragment.shardCount = 3;
+    fragment.components = {component, Component("app::Empty")};
+    return fragment;
+}
+
+void expectEqual(const ComponentFragment& expected, const ComponentFragment& actual) {
+    EXPECT_EQ(expected.sourcePath, actual.sourcePath);
+    EXPECT_EQ(expected.sourceFingerprint, actual.sourceFingerprint);
+    EXPECT_EQ(expected.ordinal, actual.ordinal);
+    EXPECT_EQ(expected.runIdentity, actual.runIdentity);
+    EXPECT_EQ(expected.shardIndex, actual.shardIndex);
+    EXPECT_EQ(expected.shardCount, actual.shardCount);
+    ASSERT_EQ(expected.components.size(), actual.components.size());
+    for (std::size_t i = 0; i < expected.components.size(); ++i) {
+        const auto& lhs = expected.components[i];
+        const auto& rhs = actual.components[i];
+        EXPECT_EQ(lhs.className(), rhs.className());
+        EXPECT_EQ(lhs.interfaces(), rhs.interfaces());
+        EXPECT_EQ(lhs.attributes(), rhs.attributes());
+        EXPECT_EQ(lhs.properties(), rhs.properties());
+        ASSERT_EQ(lhs.references().size(), rhs.references().size());
+        for (std::size_t r = 0; r < lhs.references().size(); ++r) {
+            EXPECT_EQ(lhs.references()[r].name(), rhs.references()[r].name());
+            EXPECT_EQ(lhs.references()[r].interface(), rhs.references()[r].interface());
+            EXPECT_EQ(lhs.references()[r].properties(), rhs.references()[r].properties());
+        }
+    }
+}
+
+} // namespace
+
+TEST(ComponentFragmentTest, RoundTripsInMemory) {
+    const auto fragment = sampleFragment();
+    auto decoded = decodeFragment(encodeFragment(fragment));
+
+    ASSERT_TRUE(decoded.has_value());
+    expectEqual(fragment, *decoded);
+}
+
+TEST(ComponentFragmentTest, RejectsForeignAndDamagedData) {
+    const auto bytes = encodeFragment(sampleFragment());
+
+    EXPECT_FALSE(decodeFragment("").has_value());
+    EXPECT_FALSE(decodeFragment("{\"scr\": {}}").has_value());
+    EXPECT_FALSE(decodeFragment(bytes.substr(0, bytes.size() - 1)).has_value());
+
+    auto otherVersion = bytes;
+    otherVersion[8] = static_cast<char>(otherVersion[8] + 1);
+    EXPECT_FALSE(decodeFragment(otherVersion).has_value());
+
+    auto translatedNewline = bytes;
+    translatedNewline.erase(6, 1);
+    EXPECT_FALSE(decodeFragment(translatedNewline).has_value());
+}
+
+TEST(ComponentFragmentTest, LoadsWrittenFileByMapping) {
+    const auto path = (std::filesystem::temp_directory_path() / "dsannotation_fragment_test.dsfrag").string();
+    const auto fragment = sampleFragment();
+    dsannotation::support::LocalFileSystem fileSystem;
+
+    ASSERT_NE(fileSystem.writeBinaryFile(path, encodeFragment(fragment)),
+              dsannotation::support::WriteStatus::Failed);
+    auto loaded = readFragment(path);
+    std::filesystem::remove(path);
+
+    ASSERT_TRUE(loaded.has_value());
+    expectEqual(fragment, *loaded);
+}
@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "dsannotation/parsing/ComponentRegistry.h"
+
+using dsannotation::core::Component;
+using dsannotation::core::Error;
+using dsannotation::core::ErrorCategory;
+using dsannotation::core::ErrorSeverity;
+using dsannotation::parsing::ComponentRegistry;
+
+namespace {
+
+ComponentRegistry::Parsed parsed(const std::string& className, const std::string& propertyFile) {
+    ComponentRegistry::Parsed result{Component(className), {}, {propertyFile}};
+    result.errors.push_back(Error{"warning in " + className, "a.h:1:1", ErrorSeverity::Warning,
+                                  ErrorCategory::Property});
+    return result;
+}
+
+} // namespace
+
+TEST(ComponentRegistryTest, ReuseCarriesDiagnosticsAndDependencies) {
+    ComponentRegistry registry;
+    int parses = 0;
+    auto parse = [&]() {
+        ++parses;
+        return parsed("app::Logger", "/src/logger.json");
+    };
+
+    auto first = registry.resolve("c:@S@Logger", 1, parse);
+    ASSERT_TRUE(first.component);
+    EXPECT_TRUE(first.firstSighting);
+    EXPECT_TRUE(first.dependencies.empty());
+
+    auto second = registry.resolve("c:@S@Logger", 1, parse);
+    ASSERT_TRUE(second.component);
+    EXPECT_FALSE(second.firstSighting);
+    EXPECT_EQ("app::Logger", second.component->className());
+    EXPECT_EQ(std::vector<std::string>{"/src/logger.json"}, second.dependencies);
+    ASSERT_EQ(1u, second.errors.size());
+    EXPECT_EQ("warning in app::Logger", second.errors[0].message);
+
+    EXPECT_EQ(1, parses);
+    EXPECT_EQ(1u, registry.reuseCount());
+}
+
+TEST(ComponentRegistryTest, ConflictingDefinitionIsParsedAndNotRegistered) {
+    ComponentRegistry registry;
+    registry.resolve("c:@S@Logger", 1, [] { return parsed("app::Logger", "/src/a.json"); });
+
+    auto conflict = registry.resolve("c:@S@Logger", 2, [] { return parsed("app::Logger", "/src/b.json"); });
+    ASSERT_TRUE(conflict.component);
+    EXPECT_TRUE(conflict.conflict);
+    EXPECT_TRUE(conflict.dependencies.empty());
+    EXPECT_EQ(1u, registry.conflictCount());
+
+    auto reused = registry.resolve("c:@S@Logger", 1, [] { return parsed("app::Other", "/src/c.json"); });
+    EXPECT_EQ("app::Logger", reused.component->className());
+    EXPECT_EQ(std::vector<std::string>{"/src/a.json"}, reused.dependencies);
+}
+
+TEST(ComponentRegistryTest, ConcurrentSightingsParseOnce) {
+    ComponentRegistry registry;
+    std::atomic<int> parses{0};
+    std::vector<std::thread> threads;
+    std::vector<ComponentRegistry::Resolution> resolutions(8);
+    for (std::size_t i = 0; i < resolutions.size(); ++i) {
+        threads.emplace_back([&, i] {
+            resolutions[i] = registry.resolve("c:@S@Logger", 7, [&] {
+                ++parses;
+                return parsed("app::Logger", "/src/logger.json");
+            });
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(1, parses.load());
+    for (const auto& resolution : resolutions) {
+        ASSERT_TRUE(resolution.component);
+        EXPECT_EQ("app::Logger", resolution.component->className());
+        if (!resolution.firstSighting) {
+            EXPECT_EQ(std::vector<std::string>{"/src/logger.json"}, resolution.dependencies);
+            EXPECT_EQ(1u, resolution.errors.size());
+        }
+    }
+}
@@ -0,0 +1,135 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+
+#include "dsannotation/support/LocalFileSystem.h"
+
+namespace fs = std::filesystem;
+using dsannotation::support::LocalFileSystem;
+using dsannotation::support::WriteStatus;
+
+class LocalFileSystemTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        directory_ = fs::temp_directory_path() /
+                     ("dsannotation_local_fs_" + std::to_string(::testing::UnitTest::GetInstance()->random_seed()) +
+                      "_" + ::testing::UnitTest::GetInstance()->current_test_info()->name());
+        fs::remove_all(directory_);
+    }
+
+    void TearDown() override { fs::remove_all(directory_); }
+
+    std::string path(const std::string& name) const { return (directory_ / name).string(); }
+
+    std::size_t fileCount() const {
+        std::size_t count = 0;
+        for ([[maybe_unused]] const auto& entry : fs::directory_iterator(directory_)) {
+            ++count;
+        }
+        return count;
+    }
+
+    // Moves the modification time back so that a rewrite is observable
+    void age(const std::string& file) const {
+        fs::last_write_time(file, fs::last_write_time(file) - std::chrono::hours(1));
+    }
+
+    fs::path directory_;
+    LocalFileSystem fileSystem_;
+};
+
+TEST_F(LocalFileSystemTest, WritesNewFileAndCreatesDirectories) {
+    const auto file = path("out/manifest.json");
+
+    EXPECT_EQ(fileSystem_.writeTextFile(file, "{}\n"), WriteStatus::Written);
+    EXPECT_EQ(fileSystem_.readTextFile(file), std::optional<std::string>("{}\n"));
+    EXPECT_EQ(fileCount(), 1u);
+}
+
+TEST_F(LocalFileSystemTest, SkipsUnchangedContents) {
+    const auto file = path("manifest.json");
+    ASSERT_EQ(fileSystem_.writeTextFile(file, "same"), WriteStatus::Written);
+    age(file);
+    const auto before = fs::last_write_time(file);
+
+    EXPECT_EQ(fileSystem_.writeTextFile(file, "same"), WriteStatus::Unchanged);
+    EXPECT_EQ(fileSystem_.writeTextStream(file, [](std::ostream& output) { return static_cast<bool>(output << "sa" << "me"); }),
+              WriteStatus::Unchanged);
+
+    EXPECT_EQ(fs::last_write_time(file), before);
+    EXPECT_EQ(fileCount(), 1u);
+}
+
+TEST_F(LocalFileSystemTest, ReplacesChangedContents) {
+    const auto file = path("manifest.json");
+    ASSERT_EQ(fileSystem_.writeTextFile(file, "old contents"), WriteStatus::Written);
+
+    EXPECT_EQ(fileSystem_.writeTextFile(file, "new"), WriteStatus::Written);
+    EXPECT_EQ(fileSystem_.readTextFile(file), std::optional<std::string>("new"));
+
+    EXPECT_EQ(fileSystem_.writeTextStream(file, [](std::ostream& output) { return static_cast<bool>(output << "streamed"); }),
+              WriteStatus::Written);
+    EXPECT_EQ(fileSystem_.readTextFile(file), std::optional<std::string>("streamed"));
+    EXPECT_EQ(fileCount(), 1u);
+}
+
+TEST_F(LocalFileSystemTest, FailedStreamKeepsExistingFile) {
+    const auto file = path("manifest.json");
+    ASSERT_EQ(fileSystem_.writeTextFile(file, "intact"), WriteStatus::Written);
+
+    EXPECT_EQ(fileSystem_.writeTextStream(file,
+                                          [](std::ostream& output) {
+                                              output << "partial";
+                                              return false;
+                                          }),
+              WriteStatus::Failed);
+    EXPECT_THROW(fileSystem_.writeTextStream(file,
+                                             [](std::ostream& output) -> bool {
+                                                 output << "partial";
+                                                 throw std::runtime_error("serializer failed");
+                                             }),
+                 std::runtime_error);
+
+    EXPECT_EQ(fileSystem_.readTextFile(file), std::optional<std::string>("intact"));
+    EXPECT_EQ(fileCount(), 1u);
+}
+
+TEST_F(LocalFileSystemTest, ComparesBytesNotJustSize) {
+    const auto file = path("fragment.bin");
+    ASSERT_EQ(fileSystem_.writeBinaryFile(file, "abcd"), WriteStatus::Written);
+
+    EXPECT_EQ(fileSystem_.writeBinaryFile(file, "abce"), WriteStatus::Written);
+    EXPECT_EQ(fileSystem_.writeTextStream(file, [](std::ostream& output) { return static_cast<bool>(output << "abcf"); }),
+              WriteStatus::Written);
+    EXPECT_EQ(fileSystem_.readTextFile(file), std::optional<std::string>("abcf"));
+    EXPECT_EQ(fileSystem_.writeTextStream(file, [](std::ostream& output) { return static_cast<bool>(output << "abc"); }),
+              WriteStatus::Written);
+    EXPECT_EQ(fileSystem_.readTextFile(file), std::optional<std::string>("abc"));
+}
+
+TEST_F(LocalFileSystemTest, ReportsUnwritableDirectoryAsFailure) {
+    const auto blocker = path("blocker");
+    ASSERT_EQ(fileSystem_.writeTextFile(blocker, "a file, not a directory"), WriteStatus::Written);
+
+    EXPECT_EQ(fileSystem_.writeTextFile(path("blocker/manifest.json"), "{}"), WriteStatus::Failed);
+    EXPECT_EQ(fileSystem_.writeBinaryFile(path("blocker/fragment.bin"), "{}"), WriteStatus::Failed);
+}
+
+#ifndef _WIN32
+TEST_F(LocalFileSystemTest, KeepsPermissionsAndSymlinks) {
+    const auto file = path("real/manifest.json");
+    const auto link = path("manifest.json");
+    ASSERT_EQ(fileSystem_.writeTextFile(file, "old"), WriteStatus::Written);
+    fs::permissions(file, fs::perms::owner_read | fs::perms::owner_write | fs::perms::group_read);
+    fs::create_symlink(file, link);
+
+    EXPECT_EQ(fileSystem_.writeTextFile(link, "new"), WriteStatus::Written);
+
+    EXPECT_TRUE(fs::is_symlink(link));
+    EXPECT_EQ(fileSystem_.readTextFile(file), std::optional<std::string>("new"));
+    EXPECT_EQ(fs::status(file).permissions(), fs::perms::owner_read | fs::perms::owner_write | fs::perms::group_read);
+}
+#endif
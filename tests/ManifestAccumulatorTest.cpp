@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+
+#include "dsannotation/serialization/ManifestAccumulator.h"
+
+using dsannotation::serialization::ManifestAccumulator;
+using nlohmann::json;
+
+namespace {
+
+json manifest(json components) {
+    return {{"scr", {{"version", 1}, {"components", std::move(components)}}}};
+}
+
+} // namespace
+
+TEST(ManifestAccumulatorTest, FirstDocumentIsTheBase) {
+    ManifestAccumulator accumulator;
+    accumulator.add(json::object());
+    accumulator.add({{"bundle", "app"}, {"scr", {{"version", 2}, {"components", {{{"implementation-class", "A"}}}}}}});
+    accumulator.add({{"bundle", "ignored"}, {"scr", {{"version", 3}, {"components", json::array()}}}});
+
+    const auto result = accumulator.release();
+    EXPECT_EQ(result["bundle"], "app");
+    EXPECT_EQ(result["scr"]["version"], 2);
+    EXPECT_EQ(result["scr"]["components"].size(), 1u);
+    EXPECT_TRUE(accumulator.manifest().is_null());
+}
+
+TEST(ManifestAccumulatorTest, LaterDocumentsUpdateOrAppendInOrder) {
+    ManifestAccumulator accumulator;
+    accumulator.add(manifest({{{"implementation-class", "A"}, {"immediate", true}, {"custom", 1}},
+                              {{"implementation-class", "B"}}}));
+    accumulator.add(manifest({{{"implementation-class", "C"}},
+                              {{"implementation-class", "A"}, {"immediate", false}}}));
+    accumulator.add(manifest({{{"implementation-class", "C"}, {"service", {{"interfaces", {"I"}}}}},
+                              {{"implementation-class", "D"}}}));
+
+    const auto components = accumulator.manifest()["scr"]["components"];
+    ASSERT_EQ(components.size(), 4u);
+    EXPECT_EQ(components[0], json({{"implementation-class", "A"}, {"immediate", false}, {"custom", 1}}));
+    EXPECT_EQ(components[1]["implementation-class"], "B");
+    EXPECT_EQ(components[2], json({{"implementation-class", "C"}, {"service", {{"interfaces", {"I"}}}}}));
+    EXPECT_EQ(components[3]["implementation-class"], "D");
+}
+
+TEST(ManifestAccumulatorTest, UpdatesFirstOfDuplicateEntries) {
+    ManifestAccumulator accumulator;
+    accumulator.add(manifest({{{"implementation-class", "A"}, {"n", 1}},
+                              {{"implementation-class", "A"}, {"n", 2}}}));
+    accumulator.add(manifest({{{"implementation-class", "A"}, {"n", 3}},
+                              {{"implementation-class", "B"}, {"n", 4}},
+                              {{"implementation-class", "B"}, {"n", 5}}}));
+
+    const auto components = accumulator.manifest()["scr"]["components"];
+    ASSERT_EQ(components.size(), 3u);
+    EXPECT_EQ(components[0]["n"], 3);
+    EXPECT_EQ(components[1]["n"], 2);
+    EXPECT_EQ(components[2]["n"], 5);
+}
+
+TEST(ManifestAccumulatorTest, AddsComponentsArrayToBaseWithoutOne) {
+    ManifestAccumulator accumulator;
+    accumulator.add({{"bundle", "app"}});
+    accumulator.add({{"other", true}});
+    accumulator.add(manifest({{{"implementation-class", "A"}}}));
+
+    const auto& result = accumulator.manifest();
+    EXPECT_FALSE(result.contains("other"));
+    ASSERT_TRUE(result["scr"].contains("components"));
+    EXPECT_EQ(result["scr"]["components"].size(), 1u);
+    EXPECT_FALSE(result["scr"].contains("version"));
+}
@@ -70,4 +70,36 @@ TEST_F(PropertyParserTest, ParsesRegularNumbersAsNumbers) {
     EXPECT_TRUE(result["int"].is_number_integer());
     EXPECT_TRUE(result["float"].is_number_float());
     EXPECT_TRUE(result["negative"].is_number_integer());
-}
\ No newline at end of file
+}
+
+TEST_F(PropertyParserTest, TrimsKeysAndValues) {
+    nlohmann::json result = parser.parse(" \tkey \n=\v value\f\r ,  other =  '  quoted ' ");
+    EXPECT_EQ(result["key"], "value");
+    EXPECT_EQ(result["other"], "  quoted ");
+}
+
+TEST_F(PropertyParserTest, ParsesNumberPrefixes) {
+    nlohmann::json result = parser.parse("a=1-2,b=1.5.3,c=-.5,d=5.,e=--1,f=-,g=2147483648");
+    EXPECT_EQ(result["a"], 1);
+    EXPECT_EQ(result["b"], 1.5);
+    EXPECT_EQ(result["c"], -0.5);
+    EXPECT_EQ(result["d"], 5.0);
+    EXPECT_EQ(result["e"], "--1");
+    EXPECT_EQ(result["f"], "-");
+    EXPECT_EQ(result["g"], "2147483648");
+    EXPECT_TRUE(result["d"].is_number_float());
+}
+
+TEST_F(PropertyParserTest, SplitsArrayItemsOnEveryComma) {
+    nlohmann::json result = parser.parse("a=[ x , ,y,],b=[],c=[,]");
+    EXPECT_EQ(result["a"], nlohmann::json::array({"x", "", "y"}));
+    EXPECT_EQ(result["b"], nlohmann::json::array());
+    EXPECT_EQ(result["c"], nlohmann::json::array({""}));
+}
+
+TEST_F(PropertyParserTest, NestsDottedKeysOneLevel) {
+    nlohmann::json result = parser.parse("service.name=a,service.id.x=3,empty=");
+    EXPECT_EQ(result["service"]["name"], "a");
+    EXPECT_EQ(result["service"]["id.x"], 3);
+    EXPECT_TRUE(result["empty"].is_null());
+}
@@ -0,0 +1,42 @@
+#include <gtest/gtest.h>
+
+#include "dsannotation/parsing/PropertyParser.h"
+#include "dsannotation/parsing/ReferenceAnnotations.h"
+#include "dsannotation/parsing/ReferenceParser.h"
+#include "nlohmann/json.hpp"
+
+class ReferenceParserTest : public ::testing::Test {
+protected:
+    dsannotation::parsing::PropertyParser propertyParser;
+    dsannotation::parsing::ReferenceParser parser{propertyParser};
+};
+
+TEST_F(ReferenceParserTest, MatchesByName) {
+    auto reference = parser.parse("@reference ILogger { cardinality=0..1 }", "ILogger", "app::ILogger");
+    EXPECT_EQ(reference.properties()["cardinality"], "0..1");
+}
+
+TEST_F(ReferenceParserTest, FallsBackToQualifiedType) {
+    auto reference = parser.parse("@reference app::ILogger\n{ policy=dynamic }", "ILogger", "app::ILogger");
+    EXPECT_EQ(reference.properties()["policy"], "dynamic");
+}
+
+TEST_F(ReferenceParserTest, PrefersNameOverType) {
+    const std::string comment = "@reference app::ILogger { policy=static }\n@reference ILogger { policy=dynamic }";
+    auto reference = parser.parse(comment, "ILogger", "app::ILogger");
+    EXPECT_EQ(reference.properties()["policy"], "dynamic");
+}
+
+TEST_F(ReferenceParserTest, FirstBlockForATargetWins) {
+    dsannotation::parsing::ReferenceAnnotations annotations(
+        "@reference IStore { ranking=1 } @reference IStore { ranking=2 } @reference IClock {}");
+    EXPECT_EQ(annotations.size(), 2u);
+    auto reference = parser.parse(annotations, "IStore", "db::IStore");
+    EXPECT_EQ(reference.properties()["ranking"], 1);
+}
+
+TEST_F(ReferenceParserTest, RequiresWhitespaceAfterKeywordAndClosedBlock) {
+    EXPECT_TRUE(parser.parse("@referenceIStore { a=1 }", "IStore", "IStore").properties().empty());
+    EXPECT_TRUE(parser.parse("@reference IStore { a=1", "IStore", "IStore").properties().empty());
+    EXPECT_TRUE(parser.parse("@reference IStoreX { a=1 }", "IStore", "IStore").properties().empty());
+}
@@ -0,0 +1,125 @@
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include "dsannotation/support/LocalFileSystem.h"
+#include "dsannotation/tooling/ScanCache.h"
+
+namespace fs = std::filesystem;
+using dsannotation::core::Component;
+using dsannotation::core::Error;
+using dsannotation::core::ErrorCategory;
+using dsannotation::core::ErrorSeverity;
+using dsannotation::support::LocalFileSystem;
+using dsannotation::tooling::ScanCache;
+using dsannotation::tooling::TranslationUnitResult;
+
+class ScanCacheTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        directory_ = fs::temp_directory_path() /
+                     ("dsannotation_scan_cache_" + std::to_string(::testing::UnitTest::GetInstance()->random_seed()) +
+                      "_" + ::testing::UnitTest::GetInstance()->current_test_info()->name());
+        fs::remove_all(directory_);
+        fs::create_directories(directory_ / "src");
+        write("src/main.cpp", "#include \"logger.h\"\n");
+        write("src/logger.h", "/** @component */ class Logger {};\n");
+    }
+
+    void TearDown() override { fs::remove_all(directory_); }
+
+    std::string path(const std::string& name) const { return (directory_ / name).string(); }
+
+    void write(const std::string& name, const std::string& contents) const {
+        std::ofstream(directory_ / name, std::ios::binary) << contents;
+    }
+
+    // Dependency hashes are memoized per cache, like within one run, so
+    // every step below that follows a file change uses a fresh cache.
+    ScanCache cache() const { return ScanCache(path("cache"), fileSystem_); }
+
+    TranslationUnitResult result() const {
+        TranslationUnitResult result;
+        result.sourcePath = path("src/main.cpp");
+        result.components = {Component("app::Logger")};
+        result.errors = {Error{"unknown property file", "logger.h:1:1", ErrorSeverity::Warning,
+                               ErrorCategory::Property}};
+        result.dependencies = {path("src/main.cpp"), path("src/logger.h"), path("src/logger.json")};
+        return result;
+    }
+
+    // The only entry the tests write
+    fs::path entryFile() const {
+        for (const auto& entry : fs::directory_iterator(directory_ / "cache")) {
+            return entry.path();
+        }
+        return {};
+    }
+
+    fs::path directory_;
+    LocalFileSystem fileSystem_;
+};
+
+TEST_F(ScanCacheTest, HitsForUnchangedDependencies) {
+    ASSERT_TRUE(cache().store(result(), 7));
+
+    auto cached = cache().lookup(path("src/main.cpp"), 7);
+    ASSERT_TRUE(cached.has_value());
+    ASSERT_EQ(cached->components.size(), 1u);
+    EXPECT_EQ(cached->components[0].className(), "app::Logger");
+    ASSERT_EQ(cached->errors.size(), 1u);
+    EXPECT_EQ(cached->errors[0].message, "unknown property file");
+    EXPECT_EQ(cached->errors[0].location, "logger.h:1:1");
+    EXPECT_EQ(cached->errors[0].severity, ErrorSeverity::Warning);
+    EXPECT_EQ(cached->errors[0].category, ErrorCategory::Property);
+    EXPECT_EQ(cached->dependencies, result().dependencies);
+}
+
+TEST_F(ScanCacheTest, MissesAfterDependencyChanges) {
+    ASSERT_TRUE(cache().store(result(), 7));
+    write("src/logger.h", "/** @component */ class Logger { int level; };\n");
+
+    EXPECT_FALSE(cache().lookup(path("src/main.cpp"), 7).has_value());
+}
+
+TEST_F(ScanCacheTest, MissesForOtherCommandOrSource) {
+    ASSERT_TRUE(cache().store(result(), 7));
+
+    EXPECT_FALSE(cache().lookup(path("src/main.cpp"), 8).has_value());
+    EXPECT_FALSE(cache().lookup(path("src/other.cpp"), 7).has_value());
+}
+
+TEST_F(ScanCacheTest, MissesWhenMissingDependencyAppears) {
+    ASSERT_TRUE(cache().store(result(), 7));
+    ASSERT_TRUE(cache().lookup(path("src/main.cpp"), 7).has_value());
+
+    write("src/logger.json", "{\"level\": 3}\n");
+    EXPECT_FALSE(cache().lookup(path("src/main.cpp"), 7).has_value());
+}
+
+TEST_F(ScanCacheTest, MalformedAndForeignEntriesAreMisses) {
+    ASSERT_TRUE(cache().store(result(), 7));
+    const auto file = entryFile();
+    ASSERT_FALSE(file.empty());
+    auto entry = *fileSystem_.readJsonFile(file.string());
+
+    for (const auto& damage : {std::string("{\"scr\""), std::string("[]")}) {
+        write(fs::relative(file, directory_).string(), damage);
+        EXPECT_FALSE(cache().lookup(path("src/main.cpp"), 7).has_value()) << damage;
+    }
+
+    auto expectMissWith = [&](const char* member, nlohmann::json value) {
+        auto damaged = entry;
+        damaged[member] = std::move(value);
+        write(fs::relative(file, directory_).string(), damaged.dump());
+        EXPECT_NO_THROW(EXPECT_FALSE(cache().lookup(path("src/main.cpp"), 7).has_value())) << member;
+    };
+    expectMissWith("version", "2");
+    expectMissWith("tool", 1);
+    expectMissWith("tool", "an older build");
+    expectMissWith("dependencies", nlohmann::json::array({{{"path", 5}, {"hash", nullptr}}}));
+    expectMissWith("dependencies", "src/main.cpp");
+    expectMissWith("components", nlohmann::json::array({{{"implementation-class", 5}}}));
+}
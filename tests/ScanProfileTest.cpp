@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "dsannotation/tooling/ScanProfile.h"
+
+using dsannotation::tooling::adjustForDeclarationScan;
+using dsannotation::tooling::isMsvcDriver;
+using Arguments = std::vector<std::string>;
+
+TEST(ScanProfileTest, StripsFlagsThatCannotChangeDeclarations) {
+    const Arguments arguments{"clang++", "-O2", "-g", "-ggdb3", "-Wall", "-Werror", "-pedantic", "-fPIC",
+                              "-flto=thin", "-fsanitize=address", "-fcolor-diagnostics", "-c", "main.cpp"};
+
+    EXPECT_EQ(adjustForDeclarationScan(arguments, "main.cpp"),
+              (Arguments{"clang++", "-c", "main.cpp", "-fsyntax-only", "-w"}));
+}
+
+TEST(ScanProfileTest, KeepsFlagsThatCanChangeDeclarations) {
+    const Arguments arguments{"g++", "-std=c++17", "-DLEVEL=2", "-Iinclude", "-Wp,-DFROM_WP",
+                              "-gcc-toolchain", "/opt/gcc", "-gcc-toolchain=/opt/gcc", "-fno-exceptions",
+                              "main.cpp"};
+    auto expected = arguments;
+    expected.push_back("-fsyntax-only");
+    expected.push_back("-w");
+
+    EXPECT_EQ(adjustForDeclarationScan(arguments, "main.cpp"), expected);
+}
+
+TEST(ScanProfileTest, JudgesForwardedFlagsByTheirValue) {
+    const Arguments arguments{"clang++", "-Xclang", "-Wno-foo", "-mllvm", "-O3", "-Xclang", "-fno-validate-pch",
+                              "-Xpreprocessor", "-DX", "main.cpp"};
+
+    EXPECT_EQ(adjustForDeclarationScan(arguments, "main.cpp"),
+              (Arguments{"clang++", "-Xclang", "-fno-validate-pch", "-Xpreprocessor", "-DX", "main.cpp",
+                         "-fsyntax-only", "-w"}));
+}
+
+TEST(ScanProfileTest, KeepsOptionValuesThatLookLikeFlags) {
+    const Arguments arguments{"clang++", "-o", "-Olevel.o", "-I", "-Wdir", "-include", "-g.h", "-MF", "-Werror.d",
+                              "main.cpp"};
+    auto expected = arguments;
+    expected.push_back("-fsyntax-only");
+    expected.push_back("-w");
+
+    EXPECT_EQ(adjustForDeclarationScan(arguments, "main.cpp"), expected);
+}
+
+TEST(ScanProfileTest, LeavesEverythingAfterSeparatorUntouched) {
+    const Arguments arguments{"clang++", "-O2", "--", "-O2", "-Wall.cpp"};
+
+    EXPECT_EQ(adjustForDeclarationScan(arguments, "-Wall.cpp"),
+              (Arguments{"clang++", "-fsyntax-only", "-w", "--", "-O2", "-Wall.cpp"}));
+}
+
+TEST(ScanProfileTest, StripsClStyleFlagsForClDrivers) {
+    const Arguments arguments{"C:/LLVM/bin/clang-cl.exe", "/W4", "/WX", "/wd4996", "/w14242", "/O2", "-Ob2",
+                              "/Zi", "/GL", "/Gy", "/GS-", "/RTC1", "/guard:cf", "/Zc:__cplusplus", "/MT",
+                              "/I", "/Opt/include", "/winsysroot", "/Wsdk", "/DNDEBUG", "/EHsc", "/c",
+                              "/Opt/src/main.cpp"};
+
+    EXPECT_EQ(adjustForDeclarationScan(arguments, "/Opt/src/main.cpp"),
+              (Arguments{"C:/LLVM/bin/clang-cl.exe", "/Zc:__cplusplus", "/MT", "/I", "/Opt/include", "/winsysroot",
+                         "/Wsdk", "/DNDEBUG", "/EHsc", "/c", "/Opt/src/main.cpp", "-fsyntax-only", "-w"}));
+
+    // Other drivers take /O2 for a path
+    const Arguments gccStyle{"clang++", "/O2", "main.cpp"};
+    EXPECT_EQ(adjustForDeclarationScan(gccStyle, "main.cpp"),
+              (Arguments{"clang++", "/O2", "main.cpp", "-fsyntax-only", "-w"}));
+}
+
+TEST(ScanProfileTest, DetectsClDrivers) {
+    EXPECT_TRUE(isMsvcDriver("cl"));
+    EXPECT_TRUE(isMsvcDriver("CL.EXE"));
+    EXPECT_TRUE(isMsvcDriver("/usr/bin/clang-cl"));
+    EXPECT_FALSE(isMsvcDriver("clang++"));
+    EXPECT_FALSE(isMsvcDriver("/usr/bin/cl/clang"));
+    EXPECT_FALSE(isMsvcDriver("x86_64-w64-mingw32-g++"));
+}
@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "dsannotation/tooling/ShardPartition.h"
+
+using dsannotation::config::ShardSpec;
+using dsannotation::tooling::parseShardSpec;
+using dsannotation::tooling::partitionKey;
+using dsannotation::tooling::runIdentity;
+using dsannotation::tooling::selectShard;
+
+namespace {
+
+std::vector<std::string> sampleKeys(std::size_t count) {
+    std::vector<std::string> keys;
+    for (std::size_t i = 0; i < count; ++i) {
+        keys.push_back("src/module" + std::to_string(i % 7) + "/unit" + std::to_string(i) + ".cpp");
+    }
+    return keys;
+}
+
+} // namespace
+
+TEST(ShardPartitionTest, ParsesValidSpecs) {
+    auto single = parseShardSpec("0/1");
+    ASSERT_TRUE(single.has_value());
+    EXPECT_EQ(single->index, 0u);
+    EXPECT_EQ(single->count, 1u);
+
+    auto last = parseShardSpec("2/3");
+    ASSERT_TRUE(last.has_value());
+    EXPECT_EQ(last->index, 2u);
+    EXPECT_EQ(last->count, 3u);
+}
+
+TEST(ShardPartitionTest, RejectsMalformedSpecs) {
+    for (const char* text : {"", "/", "1", "1/", "/2", "2/2", "3/2", "0/0", "a/2", "1/b", "1/2x", " 1/2", "1/2/3",
+                             "-1/2", "1/-2", "99999999999/2"}) {
+        EXPECT_FALSE(parseShardSpec(text).has_value()) << '"' << text << '"';
+    }
+}
+
+TEST(ShardPartitionTest, KeysAreRelativeToTheCompileDirectory) {
+    EXPECT_EQ(partitionKey("/home/a/ws/src/x.cpp", "/home/a/ws/build"), "../src/x.cpp");
+    EXPECT_EQ(partitionKey("/ci/ws/src/x.cpp", "/ci/ws/build/"), "../src/x.cpp");
+    EXPECT_EQ(partitionKey("../src/./x.cpp", "/ci/ws/build"), "../src/x.cpp");
+    EXPECT_EQ(partitionKey("/ci/ws/src/x.cpp", ""), "/ci/ws/src/x.cpp");
+}
+
+TEST(ShardPartitionTest, CoversEverySourceExactlyOnce) {
+    const auto keys = sampleKeys(500);
+    for (unsigned count : {1u, 2u, 3u, 8u}) {
+        std::vector<int> covered(keys.size(), 0);
+        for (unsigned index = 0; index < count; ++index) {
+            std::size_t previous = 0;
+            bool first = true;
+            for (const auto position : selectShard(keys, ShardSpec{index, count})) {
+                ASSERT_LT(position, keys.size());
+                EXPECT_TRUE(first || position > previous) << "shard positions must stay in source order";
+                previous = position;
+                first = false;
+                ++covered[position];
+            }
+        }
+        for (std::size_t i = 0; i < keys.size(); ++i) {
+            EXPECT_EQ(covered[i], 1) << keys[i] << " with " << count << " shards";
+        }
+    }
+}
+
+TEST(ShardPartitionTest, PartitionDependsOnlyOnTheKey) {
+    const auto keys = sampleKeys(50);
+    auto reordered = keys;
+    std::swap(reordered.front(), reordered.back());
+
+    const ShardSpec shard{1, 4};
+    std::set<std::string> selected;
+    for (const auto position : selectShard(keys, shard)) {
+        selected.insert(keys[position]);
+    }
+    std::set<std::string> reorderedSelected;
+    for (const auto position : selectShard(reordered, shard)) {
+        reorderedSelected.insert(reordered[position]);
+    }
+    EXPECT_EQ(selected, reorderedSelected);
+
+    EXPECT_NE(runIdentity(keys), runIdentity(reordered));
+    EXPECT_EQ(runIdentity(keys), runIdentity(sampleKeys(50)));
+    EXPECT_NE(runIdentity(keys), runIdentity(sampleKeys(49)));
+}
@@ -0,0 +1,127 @@
+#include <gtest/gtest.h>
+
+#include <random>
+#include <sstream>
+#include <string>
+
+#include "dsannotation/serialization/JsonManifestBuilder.h"
+#include "dsannotation/serialization/StreamingManifestSerializer.h"
+
+using dsannotation::core::Component;
+using dsannotation::core::ComponentList;
+using dsannotation::core::Reference;
+using dsannotation::serialization::JsonManifestBuilder;
+using dsannotation::serialization::StreamingManifestSerializer;
+
+namespace {
+
+std::string streamed(const ComponentList& components, int indentation) {
+    std::ostringstream output;
+    StreamingManifestSerializer(indentation).write(output, components);
+    return output.str();
+}
+
+std::string built(const ComponentList& components, int indentation) {
+    return JsonManifestBuilder().buildManifest(components).dump(indentation);
+}
+
+void expectIdentical(const ComponentList& components) {
+    for (int indentation : {-1, 0, 2, 4}) {
+        EXPECT_EQ(built(components, indentation), streamed(components, indentation))
+            << "indentation " << indentation;
+    }
+}
+
+} // namespace
+
+TEST(StreamingManifestSerializerTest, MatchesBuilderForEmptyList) {
+    expectIdentical({});
+}
+
+TEST(StreamingManifestSerializerTest, MatchesBuilderForTypicalComponent) {
+    Component component("app::Logger");
+    component.addInterface("app::ILogger");
+    component.addInterface("app::IFlushable");
+    component.setAttributes({{"immediate", true}, {"name", "logger \"main\"\n"}});
+    component.setProperties({{"level", "debug"}, {"sinks", {"console", "file"}}, {"limits", {{"size", 1.5}}}});
+    Reference reference("IClock", "app::IClock");
+    reference.setProperties({{"cardinality", "0..1"}, {"policy", "dynamic"}});
+    component.addReference(reference);
+    component.addReference(Reference("ISink", "app::ISink"));
+
+    expectIdentical({component, Component("app::Empty")});
+}
+
+TEST(StreamingManifestSerializerTest, MatchesBuilderForOverlappingKeys) {
+    Component serviceObject("a::ServiceObject");
+    serviceObject.addInterface("a::I");
+    serviceObject.setAttributes({{"service", {{"scope", "bundle"}}}, {"properties", "shadowed"}});
+    serviceObject.setProperties({{"x", 1}});
+
+    Component serviceScalar("a::ServiceScalar");
+    serviceScalar.addInterface("a::I");
+    serviceScalar.setAttributes({{"service", "plain"}, {"implementation-class", "other"}});
+
+    Component serviceWithoutInterfaces("a::ServiceOnly");
+    serviceWithoutInterfaces.setAttributes({{"service", nlohmann::json::object()}, {"references", 3}});
+    serviceWithoutInterfaces.addReference(Reference("r", "a::R"));
+
+    Component nonObjectAttributes("a::Array");
+    nonObjectAttributes.setAttributes({1, "two", nullptr});
+
+    Component referenceOverride("a::ReferenceOverride");
+    Reference reference("name", "a::I");
+    reference.setProperties({{"name", "renamed"}, {"interface", {1, 2}}});
+    referenceOverride.addReference(reference);
+
+    expectIdentical({serviceObject, serviceScalar, serviceWithoutInterfaces, nonObjectAttributes, referenceOverride});
+}
+
+TEST(StreamingManifestSerializerTest, MatchesBuilderForNonAsciiText) {
+    Component component("app::Caf\xc3\xa9");
+    component.setAttributes({{"label", "\xe2\x82\xac \t\x01"}, {"\xc3\xa9t\xc3\xa9", 1}});
+    expectIdentical({component});
+}
+
+TEST(StreamingManifestSerializerTest, MatchesBuilderForRandomComponents) {
+    std::mt19937 rng(1234);
+    const char* keys[] = {"service", "immediate", "name", "properties", "references", "enabled", "implementation-class"};
+    auto randomValue = [&](int depth, auto& self) -> nlohmann::json {
+        switch (rng() % (depth > 2 ? 4 : 6)) {
+            case 0: return nullptr;
+            case 1: return static_cast<int>(rng() % 1000) - 500;
+            case 2: return std::string(rng() % 4, 'a' + static_cast<char>(rng() % 26));
+            case 3: return (rng() % 2) == 0;
+            case 4: {
+                nlohmann::json array = nlohmann::json::array();
+                for (unsigned i = rng() % 3; i > 0; --i) array.push_back(self(depth + 1, self));
+                return array;
+            }
+            default: {
+                nlohmann::json object = nlohmann::json::object();
+                for (unsigned i = rng() % 3; i > 0; --i) object[keys[rng() % 7]] = self(depth + 1, self);
+                return object;
+            }
+        }
+    };
+
+    ComponentList components;
+    for (int i = 0; i < 200; ++i) {
+        Component component("ns::C" + std::to_string(i));
+        for (unsigned n = rng() % 3; n > 0; --n) component.addInterface("ns::I" + std::to_string(rng() % 10));
+        if (rng() % 2) {
+            nlohmann::json attributes = nlohmann::json::object();
+            for (unsigned n = rng() % 4; n > 0; --n) attributes[keys[rng() % 7]] = randomValue(1, randomValue);
+            component.setAttributes(attributes);
+        }
+        if (rng() % 2) component.setProperties(randomValue(1, randomValue));
+        for (unsigned n = rng() % 3; n > 0; --n) {
+            Reference reference("r" + std::to_string(n), "ns::I" + std::to_string(n));
+            if (rng() % 2) reference.setProperties({{"cardinality", "1..n"}, {keys[rng() % 7], rng() % 5}});
+            component.addReference(reference);
+        }
+        components.push_back(component);
+    }
+
+    expectIdentical(components);
+}
@@ -0,0 +1,132 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "dsannotation/parsing/AnnotationValidator.h"
+#include "dsannotation/parsing/PropertyParser.h"
+#include "dsannotation/parsing/ValidationCache.h"
+
+using namespace dsannotation::parsing;
+using dsannotation::support::SourceLocationInfo;
+
+namespace {
+
+const std::string kComment = "/**\n"
+                             " * @component { name = \"Logger\", enabled = true }\n"
+                             " * @properties { \"level\": 3 }\n"
+                             " * see my@component1\n"
+                             " */";
+
+void expectSameResult(const AnnotationValidationResult& expected, const AnnotationValidationResult& actual) {
+    ASSERT_EQ(expected.annotations.size(), actual.annotations.size());
+    for (std::size_t i = 0; i < expected.annotations.size(); ++i) {
+        const auto& lhs = expected.annotations[i];
+        const auto& rhs = actual.annotations[i];
+        EXPECT_EQ(lhs.type, rhs.type);
+        EXPECT_EQ(lhs.content, rhs.content);
+        EXPECT_EQ(lhs.location.line, rhs.location.line);
+        EXPECT_EQ(lhs.location.column, rhs.location.column);
+        EXPECT_EQ(lhs.parsedContent, rhs.parsedContent);
+        EXPECT_EQ(lhs.isValid, rhs.isValid);
+        EXPECT_EQ(lhs.hasBody, rhs.hasBody);
+    }
+    ASSERT_EQ(expected.errors.size(), actual.errors.size());
+    for (std::size_t i = 0; i < expected.errors.size(); ++i) {
+        EXPECT_EQ(expected.errors[i].message, actual.errors[i].message);
+    }
+    EXPECT_EQ(expected.warnings.size(), actual.warnings.size());
+}
+
+} // namespace
+
+class ValidationCacheTest : public ::testing::Test {
+protected:
+    PropertyParser propertyParser;
+    ValidationCache cache;
+};
+
+TEST_F(ValidationCacheTest, MatchesUncachedValidation) {
+    AnnotationValidator uncached(propertyParser);
+    AnnotationValidator cached(propertyParser, &cache);
+    const SourceLocationInfo location("a.h", 10, 5);
+
+    expectSameResult(uncached.validateComment(kComment, location), cached.validateComment(kComment, location));
+    expectSameResult(uncached.validateComment(kComment, location), cached.validateComment(kComment, location));
+
+    EXPECT_EQ(cache.misses(), 1u);
+    EXPECT_EQ(cache.hits(), 1u);
+    EXPECT_EQ(cache.size(), 1u);
+}
+
+TEST_F(ValidationCacheTest, RebasesLocationsAndDiagnostics) {
+    AnnotationValidator uncached(propertyParser);
+    AnnotationValidator cached(propertyParser, &cache);
+    const SourceLocationInfo first("a.h", 10, 5);
+    const SourceLocationInfo second("b.h", 200, 1);
+
+    cached.validateComment(kComment, first);
+    const auto result = cached.validateComment(kComment, second);
+
+    expectSameResult(uncached.validateComment(kComment, second), result);
+    EXPECT_EQ(cache.hits(), 1u);
+    ASSERT_FALSE(result.errors.empty());
+    EXPECT_NE(result.errors.front().message.find("at line 203"), std::string::npos);
+}
+
+TEST_F(ValidationCacheTest, BorrowsContentFromCallerText) {
+    AnnotationValidator cached(propertyParser, &cache);
+    const std::string copy = kComment;
+
+    cached.validateComment(kComment, {});
+    const auto result = cached.validateComment(copy, {});
+
+    ASSERT_FALSE(result.annotations.empty());
+    const auto content = result.annotations.front().content;
+    EXPECT_GE(content.data(), copy.data());
+    EXPECT_LE(content.data() + content.size(), copy.data() + copy.size());
+}
+
+TEST_F(ValidationCacheTest, DistinguishesTexts) {
+    AnnotationValidator cached(propertyParser, &cache);
+
+    cached.validateComment("/** @component */", {});
+    cached.validateComment("/** @component { a = 1 } */", {});
+    cached.validateComment("/** unbalanced { */", {});
+    cached.validateComment("/** unbalanced { */", {});
+
+    EXPECT_EQ(cache.size(), 3u);
+    EXPECT_EQ(cache.misses(), 3u);
+    EXPECT_EQ(cache.hits(), 1u);
+}
+
+TEST_F(ValidationCacheTest, IsSafeForConcurrentUse) {
+    constexpr int kThreads = 8;
+    constexpr int kTexts = 64;
+    std::vector<std::string> texts;
+    for (int i = 0; i < kTexts; ++i) {
+        texts.push_back("/** @component { id = " + std::to_string(i) + " } */");
+    }
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&] {
+            PropertyParser parser;
+            AnnotationValidator validator(parser, &cache);
+            for (int round = 0; round < 4; ++round) {
+                for (int i = 0; i < kTexts; ++i) {
+                    const auto result = validator.validateComment(texts[i], {});
+                    ASSERT_EQ(result.annotations.size(), 1u);
+                    EXPECT_EQ(result.annotations.front().parsedContent["id"], i);
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(cache.size(), static_cast<std::size_t>(kTexts));
+    EXPECT_EQ(cache.hits() + cache.misses(), static_cast<std::size_t>(kThreads * 4 * kTexts));
+}